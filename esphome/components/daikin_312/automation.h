@@ -0,0 +1,60 @@
+#pragma once
+
+#include "esphome/core/automation.h"
+#include "esphome/core/helpers.h"
+#include "daikin_312.h"
+
+#include <vector>
+
+namespace esphome {
+namespace daikin_312 {
+
+template<typename... Ts> class StartTimerAction : public Action<Ts...>, public Parented<Daikin312Climate> {
+ public:
+  void set_timer_type(Daikin312TimerType type) { this->type_ = type; }
+  TEMPLATABLE_VALUE(uint32_t, duration)
+
+  void play(Ts... x) override { this->parent_->start_timer(this->type_, this->duration_.value(x...)); }
+
+ protected:
+  Daikin312TimerType type_{DAIKIN312_TIMER_OFF};
+};
+
+template<typename... Ts> class CancelTimerAction : public Action<Ts...>, public Parented<Daikin312Climate> {
+ public:
+  void set_timer_type(Daikin312TimerType type) { this->type_ = type; }
+
+  void play(Ts... x) override { this->parent_->cancel_timer(this->type_); }
+
+ protected:
+  Daikin312TimerType type_{DAIKIN312_TIMER_OFF};
+};
+
+template<typename... Ts> class SetScheduleEntryAction : public Action<Ts...>, public Parented<Daikin312Climate> {
+ public:
+  void add_minute(uint16_t minute) { this->minutes_.push_back(minute); }
+  void set_mode(uint8_t mode) { this->mode_ = mode; }
+  void set_fan_mode(uint8_t fan_mode) { this->fan_mode_ = fan_mode; }
+  TEMPLATABLE_VALUE(float, target_temperature)
+
+  void play(Ts... x) override {
+    uint8_t target_temperature = DAIKIN312_SETTING_UNSET;
+    if (this->target_temperature_.has_value())
+      target_temperature = static_cast<uint8_t>(roundf(this->target_temperature_.value(x...)));
+    for (uint16_t minute : this->minutes_)
+      this->parent_->add_schedule_entry(minute, this->mode_, target_temperature, this->fan_mode_);
+  }
+
+ protected:
+  std::vector<uint16_t> minutes_;
+  uint8_t mode_{DAIKIN312_SETTING_UNSET};
+  uint8_t fan_mode_{DAIKIN312_SETTING_UNSET};
+};
+
+template<typename... Ts> class ClearScheduleAction : public Action<Ts...>, public Parented<Daikin312Climate> {
+ public:
+  void play(Ts... x) override { this->parent_->clear_schedule(); }
+};
+
+}  // namespace daikin_312
+}  // namespace esphome
@@ -1,9 +1,26 @@
 from esphome import automation, pins
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import climate, sensor, text_sensor
-from esphome.const import CONF_PIN, CONF_SENSOR, CONF_TRIGGER_ID
-from esphome.core import CORE
+import esphome.final_validate as fv
+from esphome.components import climate, sensor, text_sensor, time
+from esphome.const import (
+    CONF_DAYS_OF_WEEK,
+    CONF_DURATION,
+    CONF_FAN_MODE,
+    CONF_HOUR,
+    CONF_ID,
+    CONF_MINUTE,
+    CONF_MODE,
+    CONF_NUMBER,
+    CONF_PIN,
+    CONF_PLATFORM,
+    CONF_SENSOR,
+    CONF_TARGET_TEMPERATURE,
+    CONF_TIME_ID,
+    CONF_TIMEOUT,
+    CONF_TRIGGER_ID,
+    CONF_TYPE,
+)
 
 from . import CONF_DAIKIN_312_ID, Daikin312Climate, daikin_312_ns
 
@@ -16,6 +33,38 @@ CONF_EXTERNAL_TEMPERATURE = "external_temperature"
 CONF_EXTERNAL_FAN_MODE = "external_fan_mode"
 CONF_EXTERNAL_SWING_MODE = "external_swing_mode"
 
+# Current temperature publishing
+CONF_TEMPERATURE_DEADBAND = "temperature_deadband"
+CONF_TEMPERATURE_PUBLISH_INTERVAL = "temperature_publish_interval"
+
+# On-device control loop
+CONF_LOCAL_CONTROL = "local_control"
+CONF_HYSTERESIS = "hysteresis"
+CONF_KP = "kp"
+CONF_KI = "ki"
+CONF_MAX_OFFSET = "max_offset"
+CONF_MIN_CHANGE_INTERVAL = "min_change_interval"
+
+# IR receiver for the physical remote
+CONF_RECEIVER_PIN = "receiver_pin"
+CONF_VERIFY = "verify"
+CONF_MAX_RETRIES = "max_retries"
+CONF_BACKOFF = "backoff"
+
+# On-device weekly schedule
+CONF_SCHEDULE = "schedule"
+CONF_AT = "at"
+SCHEDULE_MAX_ENTRIES = 32
+DAYS_OF_WEEK = ["SUN", "MON", "TUE", "WED", "THU", "FRI", "SAT"]
+# Matches DAIKIN312_SETTING_UNSET
+SCHEDULE_UNSET = 0xFF
+
+# IR send scheduler
+CONF_COALESCE_WINDOW = "coalesce_window"
+CONF_FRAME_CACHE_SIZE = "frame_cache_size"
+CONF_RESEND_INTERVAL = "resend_interval"
+CONF_TRANSMIT_PRIORITY = "transmit_priority"
+
 # Automation trigger key
 CONF_ON_TURN_OFF = "on_turn_off"
 
@@ -28,12 +77,140 @@ Daikin312TurnOffTrigger = daikin_312_ns.class_(
     "Daikin312TurnOffTrigger", automation.Trigger.template()
 )
 
-CONFIG_SCHEMA = (
+# On/off/sleep timers
+Daikin312TimerType = daikin_312_ns.enum("Daikin312TimerType")
+TIMER_TYPES = {
+    "on": Daikin312TimerType.DAIKIN312_TIMER_ON,
+    "off": Daikin312TimerType.DAIKIN312_TIMER_OFF,
+    "sleep": Daikin312TimerType.DAIKIN312_TIMER_SLEEP,
+}
+
+Daikin312ControlType = daikin_312_ns.enum("Daikin312ControlType")
+CONTROL_TYPES = {
+    "hysteresis": Daikin312ControlType.DAIKIN312_CONTROL_HYSTERESIS,
+    "pi": Daikin312ControlType.DAIKIN312_CONTROL_PI,
+}
+
+LOCAL_CONTROL_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_TYPE, default="hysteresis"): cv.enum(CONTROL_TYPES, lower=True),
+        cv.Optional(CONF_HYSTERESIS, default=0.5): cv.positive_float,
+        cv.Optional(CONF_KP, default=1.0): cv.positive_float,
+        cv.Optional(CONF_KI, default=0.0): cv.positive_float,
+        cv.Optional(CONF_MAX_OFFSET, default=2): cv.int_range(min=1, max=5),
+        cv.Optional(
+            CONF_MIN_CHANGE_INTERVAL, default="5min"
+        ): cv.positive_time_period_milliseconds,
+    }
+)
+
+StartTimerAction = daikin_312_ns.class_("StartTimerAction", automation.Action)
+CancelTimerAction = daikin_312_ns.class_("CancelTimerAction", automation.Action)
+SetScheduleEntryAction = daikin_312_ns.class_(
+    "SetScheduleEntryAction", automation.Action
+)
+ClearScheduleAction = daikin_312_ns.class_("ClearScheduleAction", automation.Action)
+
+# Only what Daikin312Climate::traits() supports; the entries are applied as is
+SCHEDULE_MODES = {
+    mode: value
+    for mode, value in climate.CLIMATE_MODES.items()
+    if mode in ("OFF", "HEAT_COOL", "COOL", "HEAT", "DRY", "FAN_ONLY")
+}
+SCHEDULE_FAN_MODES = {
+    fan_mode: value
+    for fan_mode, value in climate.CLIMATE_FAN_MODES.items()
+    if fan_mode in ("AUTO", "QUIET", "LOW", "MEDIUM", "HIGH")
+}
+
+SCHEDULE_ENTRY_FIELDS = {
+    cv.Optional(CONF_DAYS_OF_WEEK, default=DAYS_OF_WEEK): cv.ensure_list(
+        cv.one_of(*DAYS_OF_WEEK, upper=True)
+    ),
+    cv.Required(CONF_AT): cv.time_of_day,
+    cv.Optional(CONF_MODE): cv.enum(SCHEDULE_MODES, upper=True),
+    cv.Optional(CONF_FAN_MODE): cv.enum(SCHEDULE_FAN_MODES, upper=True),
+}
+
+SCHEDULE_ENTRY_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            **SCHEDULE_ENTRY_FIELDS,
+            cv.Optional(CONF_TARGET_TEMPERATURE): cv.All(
+                cv.temperature, cv.float_range(min=10, max=32)
+            ),
+        }
+    ),
+    cv.has_at_least_one_key(CONF_MODE, CONF_TARGET_TEMPERATURE, CONF_FAN_MODE),
+)
+
+
+def schedule_minutes(entry):
+    """Minutes of the week (0 is Sunday 00:00) an entry applies at."""
+    at = entry[CONF_AT]
+    return sorted(
+        DAYS_OF_WEEK.index(day) * 24 * 60 + at[CONF_HOUR] * 60 + at[CONF_MINUTE]
+        for day in set(entry[CONF_DAYS_OF_WEEK])
+    )
+
+
+def validate_schedule(config):
+    if CONF_SCHEDULE not in config:
+        return config
+    if CONF_TIME_ID not in config:
+        raise cv.Invalid("'schedule' requires 'time_id'")
+    minutes = set()
+    for entry in config[CONF_SCHEDULE]:
+        minutes.update(schedule_minutes(entry))
+    if len(minutes) > SCHEDULE_MAX_ENTRIES:
+        raise cv.Invalid(
+            f"'schedule' expands to {len(minutes)} transitions, at most {SCHEDULE_MAX_ENTRIES} are supported"
+        )
+    return config
+
+
+def validate_local_control(config):
+    if CONF_LOCAL_CONTROL in config and CONF_SENSOR not in config:
+        raise cv.Invalid("'local_control' requires 'sensor'")
+    return config
+
+
+def validate_verify(config):
+    if CONF_VERIFY in config and CONF_RECEIVER_PIN not in config:
+        raise cv.Invalid("'verify' requires 'receiver_pin'")
+    return config
+
+
+VERIFY_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_TIMEOUT, default="500ms"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_MAX_RETRIES, default=3): cv.int_range(min=0, max=5),
+        cv.Optional(CONF_BACKOFF, default="250ms"): cv.positive_time_period_milliseconds,
+    }
+)
+
+
+CONFIG_SCHEMA = cv.All(
     climate.climate_schema(Daikin312Climate)
     .extend(
         {
             cv.Required(CONF_PIN): pins.internal_gpio_output_pin_schema,
+            cv.Optional(CONF_RECEIVER_PIN): pins.internal_gpio_input_pin_schema,
+            cv.Optional(CONF_VERIFY): VERIFY_SCHEMA,
             cv.Optional(CONF_SENSOR): cv.use_id(sensor.Sensor),
+            cv.Optional(CONF_LOCAL_CONTROL): LOCAL_CONTROL_SCHEMA,
+            cv.Optional(CONF_TEMPERATURE_DEADBAND, default=0.1): cv.positive_float,
+            cv.Optional(
+                CONF_TEMPERATURE_PUBLISH_INTERVAL, default="1s"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(
+                CONF_COALESCE_WINDOW, default="50ms"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_FRAME_CACHE_SIZE, default=6): cv.int_range(min=1, max=16),
+            cv.Optional(CONF_RESEND_INTERVAL): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
+            cv.Optional(CONF_SCHEDULE): cv.ensure_list(SCHEDULE_ENTRY_SCHEMA),
+            cv.Optional(CONF_TRANSMIT_PRIORITY, default=0): cv.int_range(min=0, max=255),
             # External state sync from Home Assistant Daikin integration
             cv.Optional(CONF_EXTERNAL_MODE): cv.use_id(text_sensor.TextSensor),
             cv.Optional(CONF_EXTERNAL_TEMPERATURE): cv.use_id(sensor.Sensor),
@@ -47,25 +224,87 @@ CONFIG_SCHEMA = (
             ),
         }
     )
-    .extend(cv.COMPONENT_SCHEMA)
+    .extend(cv.COMPONENT_SCHEMA),
+    validate_local_control,
+    validate_verify,
+    validate_schedule,
 )
 
 
-async def to_code(config):
-    # Enable serial on ESP8266 as IRremoteESP8266 library uses Serial
-    if CORE.is_esp8266:
-        from esphome.components.esp8266.const import enable_serial
-        enable_serial()
+def final_validate_frame_cache_size(config):
+    # Units on one pin share a single frame cache; the bus sizes it for the
+    # largest request, so differing values would silently change the others
+    pin = config[CONF_PIN][CONF_NUMBER]
+    for other in fv.full_config.get().get("climate", []):
+        if other.get(CONF_PLATFORM) != "daikin_312" or other[CONF_PIN][CONF_NUMBER] != pin:
+            continue
+        if other[CONF_FRAME_CACHE_SIZE] != config[CONF_FRAME_CACHE_SIZE]:
+            raise cv.Invalid(
+                f"Units on pin {pin} share one frame cache, set the same 'frame_cache_size' on all of them",
+                path=[CONF_FRAME_CACHE_SIZE],
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = final_validate_frame_cache_size
+
 
+async def to_code(config):
     var = await climate.new_climate(config)
     await cg.register_component(var, config)
 
     pin = await cg.gpio_pin_expression(config[CONF_PIN])
     cg.add(var.set_pin(pin))
+    if CONF_RECEIVER_PIN in config:
+        receiver_pin = await cg.gpio_pin_expression(config[CONF_RECEIVER_PIN])
+        cg.add(var.set_receiver_pin(receiver_pin))
+    if CONF_VERIFY in config:
+        verify = config[CONF_VERIFY]
+        cg.add(
+            var.set_verify(
+                verify[CONF_TIMEOUT], verify[CONF_MAX_RETRIES], verify[CONF_BACKOFF]
+            )
+        )
+    cg.add(var.set_coalesce_window(config[CONF_COALESCE_WINDOW]))
+    cg.add(var.set_frame_cache_size(config[CONF_FRAME_CACHE_SIZE]))
+    if CONF_RESEND_INTERVAL in config:
+        cg.add(var.set_resend_interval(config[CONF_RESEND_INTERVAL]))
+    cg.add(var.set_transmit_priority(config[CONF_TRANSMIT_PRIORITY]))
 
     if sensor_config := config.get(CONF_SENSOR):
         sens = await cg.get_variable(sensor_config)
         cg.add(var.set_sensor(sens))
+        cg.add(var.set_temperature_deadband(config[CONF_TEMPERATURE_DEADBAND]))
+        cg.add(
+            var.set_temperature_publish_interval(
+                config[CONF_TEMPERATURE_PUBLISH_INTERVAL]
+            )
+        )
+
+    if local_control := config.get(CONF_LOCAL_CONTROL):
+        cg.add(
+            var.set_local_control(
+                local_control[CONF_TYPE],
+                local_control[CONF_MAX_OFFSET],
+                local_control[CONF_MIN_CHANGE_INTERVAL],
+            )
+        )
+        cg.add(var.set_control_hysteresis(local_control[CONF_HYSTERESIS]))
+        cg.add(var.set_control_gains(local_control[CONF_KP], local_control[CONF_KI]))
+
+    if time_id := config.get(CONF_TIME_ID):
+        rtc = await cg.get_variable(time_id)
+        cg.add(var.set_time(rtc))
+    for entry in config.get(CONF_SCHEDULE, []):
+        for minute in schedule_minutes(entry):
+            cg.add(
+                var.add_schedule_entry(
+                    minute,
+                    entry.get(CONF_MODE, SCHEDULE_UNSET),
+                    round(entry.get(CONF_TARGET_TEMPERATURE, SCHEDULE_UNSET)),
+                    entry.get(CONF_FAN_MODE, SCHEDULE_UNSET),
+                )
+            )
 
     # External state sync sensors
     if external_mode := config.get(CONF_EXTERNAL_MODE):
@@ -90,19 +329,89 @@ async def to_code(config):
         cg.add(var.set_turn_off_trigger(trigger))
         await automation.build_automation(trigger, [], conf)
 
-    # Optimize IRremoteESP8266 build - disable all protocols except DAIKIN312
-    # This significantly reduces binary size
-    # BUT: if irremote_debug component is also used, we need all protocols
-    # enabled for debugging, so skip the restrictive flags
-    if "irremote_debug" not in CORE.config:
-        cg.add_build_flag("-D_IR_ENABLE_DEFAULT_=false")
-        cg.add_build_flag("-DSEND_DAIKIN312=true")
-        cg.add_build_flag("-DDECODE_DAIKIN312=true")
-
-    cg.add_library(
-        "IRremoteESP8266",
-        None,
-        # "https://github.com/carl09/IRremoteESP8266.git#daikin_312",
-        "https://github.com/crankyoldgit/irremoteesp8266#master",
-    )
 
+@automation.register_action(
+    "daikin_312.start_timer",
+    StartTimerAction,
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.use_id(Daikin312Climate),
+            cv.Required(CONF_TYPE): cv.enum(TIMER_TYPES, lower=True),
+            cv.Required(CONF_DURATION): cv.templatable(
+                cv.positive_time_period_milliseconds
+            ),
+        }
+    ),
+)
+async def start_timer_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    cg.add(var.set_timer_type(config[CONF_TYPE]))
+    duration = await cg.templatable(config[CONF_DURATION], args, cg.uint32)
+    cg.add(var.set_duration(duration))
+    return var
+
+
+@automation.register_action(
+    "daikin_312.cancel_timer",
+    CancelTimerAction,
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.use_id(Daikin312Climate),
+            cv.Required(CONF_TYPE): cv.enum(TIMER_TYPES, lower=True),
+        }
+    ),
+)
+async def cancel_timer_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    cg.add(var.set_timer_type(config[CONF_TYPE]))
+    return var
+
+
+@automation.register_action(
+    "daikin_312.set_schedule_entry",
+    SetScheduleEntryAction,
+    cv.All(
+        cv.Schema(
+            {
+                cv.GenerateID(): cv.use_id(Daikin312Climate),
+                **SCHEDULE_ENTRY_FIELDS,
+                cv.Optional(CONF_TARGET_TEMPERATURE): cv.templatable(
+                    cv.All(cv.temperature, cv.float_range(min=10, max=32))
+                ),
+            }
+        ),
+        cv.has_at_least_one_key(CONF_MODE, CONF_TARGET_TEMPERATURE, CONF_FAN_MODE),
+    ),
+)
+async def set_schedule_entry_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    for minute in schedule_minutes(config):
+        cg.add(var.add_minute(minute))
+    if CONF_MODE in config:
+        cg.add(var.set_mode(config[CONF_MODE]))
+    if CONF_FAN_MODE in config:
+        cg.add(var.set_fan_mode(config[CONF_FAN_MODE]))
+    if CONF_TARGET_TEMPERATURE in config:
+        target_temperature = await cg.templatable(
+            config[CONF_TARGET_TEMPERATURE], args, cg.float_
+        )
+        cg.add(var.set_target_temperature(target_temperature))
+    return var
+
+
+@automation.register_action(
+    "daikin_312.clear_schedule",
+    ClearScheduleAction,
+    automation.maybe_simple_id(
+        {
+            cv.GenerateID(): cv.use_id(Daikin312Climate),
+        }
+    ),
+)
+async def clear_schedule_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    return var
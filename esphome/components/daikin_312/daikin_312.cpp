@@ -2,31 +2,39 @@
 #include "esphome/core/log.h"
 #include "esphome/components/climate/climate_mode.h"
 
-#include <IRremoteESP8266.h>
-#include <IRsend.h>
-#include <ir_Daikin.h>
+#include <cinttypes>
 
 namespace esphome {
 namespace daikin_312 {
 
 static const char *const TAG = "daikin_312.climate";
 
+// Scheduler names of the on/off/sleep timers, indexed by Daikin312TimerType
+static const char *const TIMER_NAMES[] = {"on_timer", "off_timer", "sleep_timer"};
+
 const uint8_t DEFAULT_TEMP_MIN = 18;         // Celsius
 const uint8_t DEFAULT_TEMP_MAX = 31;         // Celsius
 const uint8_t DEFAULT_TARGET_TEMP_MAX = 22;  // Celsius
+const uint32_t SETTINGS_SAVE_DELAY_MS = 5000;
+const uint32_t SETTINGS_PREF_SALT = 0x0D312000;  // keeps the settings blob apart from the climate's own preference
+const uint32_t SCHEDULE_PREF_SALT = 0x0D312500;
+// Transitions fire just after the minute starts so clock jitter never runs them early
+const uint32_t SCHEDULE_MARGIN_MS = 1000;
 const uint32_t POWERFUL_MODE_DURATION_MS = 20 * 60 * 1000;  // 20 minutes in milliseconds
 
 void Daikin312Climate::setup() {
   if (this->sensor_) {
-    this->sensor_->add_on_state_callback([this](float state) {
-      this->current_temperature = state;
-      this->publish_state();
-    });
+    this->sensor_->add_on_state_callback([this](float state) { this->update_current_temperature_(state); });
     this->current_temperature = this->sensor_->state;
   } else {
     this->current_temperature = NAN;
   }
 
+  this->add_on_state_callback([this](climate::Climate & /*climate*/) {
+    this->telemetry_.state_publishes++;
+    this->schedule_telemetry_publish_();
+  });
+
   // Setup external state sensors for syncing from HA Daikin integration
   if (this->external_mode_sensor_) {
     this->external_mode_sensor_->add_on_state_callback([this](const std::string &state) {
@@ -49,55 +57,458 @@ void Daikin312Climate::setup() {
     });
   }
 
-  // restore set points
-  auto restore = this->restore_state_();
-
-  if (restore.has_value()) {
-    restore->apply(this);
+  // restore set points, preferring the combined settings blob
+  this->settings_pref_ =
+      global_preferences->make_preference<Daikin312Settings>(this->get_preference_hash() ^ SETTINGS_PREF_SALT);
+  if (this->settings_pref_.load(&this->saved_settings_)) {
+    // The base climate preference is never set up, so publish_state() does
+    // not write a second copy of the state next to the blob
+    this->settings_loaded_ = true;
+    this->apply_saved_settings_();
   } else {
-    // restore from defaults
-    this->mode = climate::CLIMATE_MODE_OFF;
-    this->target_temperature = DEFAULT_TARGET_TEMP_MAX;
-    this->fan_mode = climate::CLIMATE_FAN_AUTO;
-    this->swing_mode = climate::CLIMATE_SWING_OFF;
+    auto restore = this->restore_state_();
+    if (restore.has_value()) {
+      restore->apply(this);
+    } else {
+      // restore from defaults
+      this->mode = climate::CLIMATE_MODE_OFF;
+      this->target_temperature = DEFAULT_TARGET_TEMP_MAX;
+      this->fan_mode = climate::CLIMATE_FAN_AUTO;
+      this->swing_mode = climate::CLIMATE_SWING_OFF;
+    }
   }
 
   if (isnan(this->target_temperature))
     this->target_temperature = DEFAULT_TARGET_TEMP_MAX;
 
-  this->ac_ = new IRDaikin312(this->pin_->get_pin());
-  this->ac_->begin();
+  // Units on the same pin share one transmitter and take turns sending
+  this->bus_ = Daikin312Bus::get_or_create(this->pin_, this->frame_cache_size_);
 
   // Syncing Remote settings
-  this->set_mode_(false);
-  this->set_fan_mode_(false);
-  this->set_swing_mode_(false);
-  this->set_target_temperature_(false);
+  this->set_mode_();
+  this->set_fan_mode_();
+  this->set_swing_mode_();
+  this->set_target_temperature_();
+
+  this->ir_state_.set_purify(this->purify_enabled_);
+  if (this->settings_loaded_) {
+    const Daikin312Settings &saved = this->saved_settings_;
+    if ((saved.saved & DAIKIN312_SETTING_LIGHT) && is_option_value(LIGHT_OPTION_VALUES, saved.light))
+      this->ir_state_.set_light(saved.light);
+    if ((saved.saved & DAIKIN312_SETTING_BEEP) && is_option_value(BEEP_OPTION_VALUES, saved.beep))
+      this->ir_state_.set_beep(saved.beep);
+    if (saved.saved & DAIKIN312_SETTING_EYE)
+      this->ir_state_.set_eye(saved.flags & DAIKIN312_SETTING_EYE);
+    if (saved.saved & DAIKIN312_SETTING_EYE_AUTO)
+      this->ir_state_.set_eye_auto(saved.flags & DAIKIN312_SETTING_EYE_AUTO);
+  }
+
+  // Assume the AC is already in the restored state. Switches and selects apply
+  // their restored values during their own setup without transmitting; once
+  // every component is set up a single frame is sent, or none when the
+  // restored settings match this state.
+  memcpy(this->last_sent_state_, this->ir_state_.get_raw(), DAIKIN312_STATE_LENGTH);
+  this->last_sent_valid_ = true;
+  this->set_timeout("boot_restore", 0, [this]() { this->finish_restore_(); });
+
+  if (this->receiver_pin_ != nullptr) {
+    // The edge interrupt wakes loop() while a frame is being captured
+    this->receiver_.setup(this->receiver_pin_, this);
+  }
+  this->disable_loop();
+
+  this->schedule_.load(this->get_preference_hash() ^ SCHEDULE_PREF_SALT);
+  this->schedule_loaded_ = true;
+#ifdef USE_TIME
+  if (this->time_ != nullptr) {
+    // Only transitions are applied, so changes made in between stay until the next one
+    this->time_->add_on_time_sync_callback([this]() { this->schedule_next_transition_(); });
+    this->schedule_next_transition_();
+  }
+#endif
+
+  if (this->resend_interval_ > 0) {
+    // Periodically repeat the last transmitted state in case a frame was missed
+    this->set_interval("resend", this->resend_interval_, [this]() {
+      if (this->last_sent_valid_) {
+        this->pending_sources_ |= 1 << DAIKIN312_SOURCE_INTERNAL;
+        this->transmit_state_(true);
+      }
+    });
+  }
+}
+
+void Daikin312Climate::apply_saved_settings_() {
+  // The blob may come from an older firmware or be corrupted, so only values
+  // this model supports are applied; anything else keeps its default
+  const Daikin312Settings &saved = this->saved_settings_;
+  if (saved.mode < sizeof(DAIKIN_MODES)) {
+    this->mode = static_cast<climate::ClimateMode>(saved.mode);
+  } else {
+    ESP_LOGW(TAG, "Ignoring saved mode %u", saved.mode);
+  }
+  if (saved.target_temperature >= DEFAULT_TEMP_MIN && saved.target_temperature <= DEFAULT_TEMP_MAX) {
+    this->target_temperature = saved.target_temperature;
+  } else {
+    ESP_LOGW(TAG, "Ignoring saved target temperature %u", saved.target_temperature);
+  }
+  if (saved.fan_mode == climate::CLIMATE_FAN_QUIET ||
+      (saved.fan_mode < sizeof(DAIKIN_FAN_SPEEDS) && DAIKIN_FAN_SPEEDS[saved.fan_mode] != DAIKIN_FAN_NONE)) {
+    this->fan_mode = static_cast<climate::ClimateFanMode>(saved.fan_mode);
+  } else if (saved.fan_mode != DAIKIN312_SETTING_UNSET) {
+    ESP_LOGW(TAG, "Ignoring saved fan mode %u", saved.fan_mode);
+  }
+  if (saved.swing_mode < sizeof(DAIKIN_SWINGS) / sizeof(DAIKIN_SWINGS[0])) {
+    this->swing_mode = static_cast<climate::ClimateSwingMode>(saved.swing_mode);
+  } else {
+    ESP_LOGW(TAG, "Ignoring saved swing mode %u", saved.swing_mode);
+  }
+  switch (saved.preset) {
+    case climate::CLIMATE_PRESET_NONE:
+    case climate::CLIMATE_PRESET_BOOST:
+    case climate::CLIMATE_PRESET_ECO:
+    case climate::CLIMATE_PRESET_SLEEP:
+      this->preset = static_cast<climate::ClimatePreset>(saved.preset);
+      break;
+    case DAIKIN312_SETTING_UNSET:
+      break;
+    default:
+      ESP_LOGW(TAG, "Ignoring saved preset %u", saved.preset);
+      break;
+  }
+  if (saved.saved & DAIKIN312_SETTING_PURIFY)
+    this->purify_enabled_ = saved.flags & DAIKIN312_SETTING_PURIFY;
+}
+
+bool Daikin312Climate::has_saved_setting(Daikin312Setting setting) const {
+  return this->settings_loaded_ && (this->saved_settings_.saved & setting);
+}
 
-  this->ac_->setPurify(true);
-  this->ac_->setPurify(this->purify_enabled_);
+void Daikin312Climate::schedule_settings_save_() {
+  // Restarted by every change, so a burst of changes is written once
+  this->set_timeout("save_settings", SETTINGS_SAVE_DELAY_MS, [this]() { this->commit_settings_(); });
+}
+
+void Daikin312Climate::commit_settings_() {
+  Daikin312Settings settings{};
+  settings.mode = this->mode;
+  settings.target_temperature = static_cast<uint8_t>(roundf(this->target_temperature));
+  settings.fan_mode =
+      this->fan_mode.has_value() ? static_cast<uint8_t>(this->fan_mode.value()) : DAIKIN312_SETTING_UNSET;
+  settings.swing_mode = this->swing_mode;
+  settings.preset = this->preset.has_value() ? static_cast<uint8_t>(this->preset.value()) : DAIKIN312_SETTING_UNSET;
+  settings.light = this->ir_state_.get_light();
+  settings.beep = this->ir_state_.get_beep();
+  settings.flags = (this->ir_state_.get_eye() ? DAIKIN312_SETTING_EYE : 0) |
+                   (this->ir_state_.get_eye_auto() ? DAIKIN312_SETTING_EYE_AUTO : 0) |
+                   (this->purify_enabled_ ? DAIKIN312_SETTING_PURIFY : 0);
+  settings.saved = this->changed_settings_ | (this->settings_loaded_ ? this->saved_settings_.saved : 0);
+
+  if (this->settings_loaded_ && memcmp(&settings, &this->saved_settings_, sizeof(settings)) == 0) {
+    this->settings_writes_skipped_++;
+    return;
+  }
+  if (this->settings_pref_.save(&settings)) {
+    this->saved_settings_ = settings;
+    this->settings_loaded_ = true;
+    // Drop the base climate preference restored from before the blob existed
+    this->rtc_ = ESPPreferenceObject();
+    this->settings_writes_++;
+    ESP_LOGV(TAG, "Settings saved (%" PRIu32 " writes)", this->settings_writes_);
+  }
 }
 
 void Daikin312Climate::loop() {
-  // Check if powerful mode should auto-expire (AC unit turns it off after 20 mins)
-  if (this->powerful_mode_active_) {
-    uint32_t now = millis();
-    if ((now - this->powerful_mode_start_time_) >= POWERFUL_MODE_DURATION_MS) {
-      this->clear_powerful_mode_();
+  uint8_t state[DAIKIN312_STATE_LENGTH];
+  if (this->receiver_.poll(state))
+    this->apply_received_state_(state);
+  if (this->receiver_.is_idle())
+    this->disable_loop();
+}
+
+void Daikin312Climate::apply_received_state_(const uint8_t *state) {
+  if (this->last_sent_valid_ && memcmp(state, this->last_sent_state_, DAIKIN312_STATE_LENGTH) == 0) {
+    if (this->verify_pending_) {
+      this->cancel_verify_();
+      this->telemetry_.frames_verified++;
+      this->schedule_telemetry_publish_();
+      ESP_LOGV(TAG, "Frame verified after %u retries", this->verify_attempts_);
+    } else {
+      ESP_LOGV(TAG, "Received frame matches the current state");
+    }
+    return;
+  }
+
+  // The remote's frame replaces ours, so there is nothing left to verify
+  this->cancel_verify_();
+
+  // The remote's frame is the newest state; drop any change still waiting to be sent
+  if (this->transmit_pending_) {
+    this->cancel_timeout("transmit");
+    this->transmit_pending_ = false;
+    this->pending_sources_ = 0;
+  }
+  this->ir_state_.set_raw(state);
+  memcpy(this->last_sent_state_, state, DAIKIN312_STATE_LENGTH);
+  this->last_sent_valid_ = true;
+  this->telemetry_.frames_received++;
+
+  this->mode = this->ir_state_.get_power() ? climate_mode_from_daikin(this->ir_state_.get_mode())
+                                           : climate::CLIMATE_MODE_OFF;
+  if (this->mode != climate::CLIMATE_MODE_OFF)
+    this->last_active_mode_ = this->mode;
+  this->target_temperature = this->ir_state_.get_temp() - this->setpoint_offset_;
+
+  this->clear_custom_fan_mode_();
+  this->powerful_mode_active_ = false;
+  this->cancel_timeout("powerful");
+  this->fan_mode = this->ir_state_.get_quiet() ? climate::CLIMATE_FAN_QUIET
+                                               : climate_fan_mode_from_daikin(this->ir_state_.get_fan());
+  this->swing_mode =
+      climate_swing_mode_from_daikin(this->ir_state_.get_swing_vertical(), this->ir_state_.get_swing_horizontal());
+  if (this->ir_state_.get_powerful()) {
+    this->preset = climate::CLIMATE_PRESET_BOOST;
+  } else if (this->ir_state_.get_econo()) {
+    this->preset = climate::CLIMATE_PRESET_ECO;
+  } else {
+    this->preset = climate::CLIMATE_PRESET_NONE;
+  }
+  this->purify_enabled_ = this->ir_state_.get_purify();
+  // The frame carries every setting, so all of them now reflect the remote
+  this->changed_settings_ |= DAIKIN312_SETTING_EYE | DAIKIN312_SETTING_EYE_AUTO | DAIKIN312_SETTING_PURIFY |
+                             DAIKIN312_SETTING_LIGHT | DAIKIN312_SETTING_BEEP;
+
+  ESP_LOGD(TAG, "State updated from remote control");
+  this->settings_callback_.call();
+  this->schedule_publish_();
+}
+
+void Daikin312Climate::start_timer(Daikin312TimerType type, uint32_t duration_ms) {
+  if (type == DAIKIN312_TIMER_SLEEP) {
+    // Sleep runs the quiet sleep preset now and switches the AC off when it expires
+    this->preset = climate::CLIMATE_PRESET_SLEEP;
+    this->set_preset_();
+    this->schedule_transmit_(DAIKIN312_SOURCE_INTERNAL);
+    this->publish_state();
+  }
+
+  ESP_LOGD(TAG, "%s timer started: %" PRIu32 " s", TIMER_NAMES[type], duration_ms / 1000);
+  this->timer_deadlines_[type] = millis() + duration_ms;
+  this->set_timeout(TIMER_NAMES[type], duration_ms, [this, type]() { this->on_timer_expired_(type); });
+}
+
+void Daikin312Climate::cancel_timer(Daikin312TimerType type) {
+  if (this->cancel_timeout(TIMER_NAMES[type])) {
+    ESP_LOGD(TAG, "%s timer cancelled", TIMER_NAMES[type]);
+  }
+  this->timer_deadlines_[type].reset();
+}
+
+void Daikin312Climate::on_timer_expired_(Daikin312TimerType type) {
+  ESP_LOGD(TAG, "%s timer expired", TIMER_NAMES[type]);
+  this->timer_deadlines_[type].reset();
+
+  if (type == DAIKIN312_TIMER_ON) {
+    if (this->mode != climate::CLIMATE_MODE_OFF)
+      return;
+    this->mode = this->last_active_mode_;
+  } else {
+    bool sleep_preset = type == DAIKIN312_TIMER_SLEEP && this->preset.has_value() &&
+                        this->preset.value() == climate::CLIMATE_PRESET_SLEEP;
+    if (sleep_preset) {
+      // The next power-on starts without the quiet sleep preset
+      this->preset = climate::CLIMATE_PRESET_NONE;
+      this->set_preset_();
+    }
+    if (this->mode == climate::CLIMATE_MODE_OFF) {
+      if (sleep_preset) {
+        this->schedule_transmit_(DAIKIN312_SOURCE_INTERNAL);
+        this->publish_state();
+      }
+      return;
+    }
+    this->mode = climate::CLIMATE_MODE_OFF;
+    if (this->turn_off_trigger_ != nullptr) {
+      this->turn_off_trigger_->trigger();
+    }
+  }
+  this->set_mode_();
+  this->schedule_transmit_(DAIKIN312_SOURCE_INTERNAL);
+  this->publish_state();
+}
+
+void Daikin312Climate::add_schedule_entry(uint16_t minute, uint8_t mode, uint8_t target_temperature,
+                                          uint8_t fan_mode) {
+  if (this->schedule_.add({static_cast<uint16_t>(minute % DAIKIN312_MINUTES_PER_WEEK), mode, target_temperature,
+                           fan_mode}))
+    this->schedule_changed_();
+}
+
+void Daikin312Climate::clear_schedule() {
+  this->schedule_.clear();
+  this->schedule_changed_();
+}
+
+void Daikin312Climate::schedule_changed_() {
+  // Entries from the configuration are the defaults loaded in setup()
+  if (!this->schedule_loaded_)
+    return;
+  // Restarted by every change, so entries set together are written once
+  this->set_timeout("save_schedule", SETTINGS_SAVE_DELAY_MS, [this]() { this->schedule_.save(); });
+  this->schedule_next_transition_();
+}
+
+void Daikin312Climate::schedule_next_transition_() {
+#ifdef USE_TIME
+  if (this->time_ == nullptr)
+    return;
+  ESPTime now = this->time_->now();
+  if (this->schedule_.empty() || !now.is_valid()) {
+    this->cancel_timeout("schedule");
+    return;
+  }
+
+  uint16_t minute = Daikin312Schedule::minute_of_week(now);
+  uint16_t next = this->schedule_.next_transition(minute);
+  uint32_t minutes = (next + DAIKIN312_MINUTES_PER_WEEK - minute) % DAIKIN312_MINUTES_PER_WEEK;
+  if (minutes == 0)
+    minutes = DAIKIN312_MINUTES_PER_WEEK;  // a single entry repeats a week later
+  uint32_t delay = minutes * 60000 - now.second * 1000 + SCHEDULE_MARGIN_MS;
+  ESP_LOGV(TAG, "Next schedule transition in %" PRIu32 " s", delay / 1000);
+  this->set_timeout("schedule", delay, [this]() { this->run_schedule_(); });
+#endif
+}
+
+void Daikin312Climate::run_schedule_() {
+#ifdef USE_TIME
+  ESPTime now = this->time_->now();
+  if (now.is_valid()) {
+    const Daikin312ScheduleEntry *entry = this->schedule_.find_active(Daikin312Schedule::minute_of_week(now));
+    if (entry != nullptr)
+      this->apply_schedule_entry_(*entry);
+  }
+  this->schedule_next_transition_();
+#endif
+}
+
+void Daikin312Climate::apply_schedule_entry_(const Daikin312ScheduleEntry &entry) {
+  ESP_LOGD(TAG, "Applying schedule entry at minute %u", entry.minute);
+  // Every field is applied before one transmit, so a transition is a single frame
+  if (entry.mode != DAIKIN312_SETTING_UNSET) {
+    this->mode = static_cast<climate::ClimateMode>(entry.mode);
+    this->set_mode_();
+    if (this->mode == climate::CLIMATE_MODE_OFF && this->turn_off_trigger_ != nullptr)
+      this->turn_off_trigger_->trigger();
+  }
+  if (entry.target_temperature != DAIKIN312_SETTING_UNSET) {
+    this->target_temperature = entry.target_temperature;
+    this->set_target_temperature_();
+  }
+  if (entry.fan_mode != DAIKIN312_SETTING_UNSET) {
+    this->clear_custom_fan_mode_();
+    this->fan_mode = static_cast<climate::ClimateFanMode>(entry.fan_mode);
+    this->set_fan_mode_();
+  }
+  this->schedule_transmit_(DAIKIN312_SOURCE_INTERNAL);
+  this->publish_state();
+}
+
+void Daikin312Climate::update_current_temperature_(float state) {
+  if (this->local_control_)
+    this->run_local_control_(state);
+
+  // Readings within the deadband of the published value are dropped, and a
+  // pending publish of an earlier reading is no longer needed either.
+  bool was_nan = std::isnan(this->current_temperature);
+  if (was_nan == std::isnan(state) &&
+      (was_nan || std::fabs(state - this->current_temperature) < this->temperature_deadband_)) {
+    this->cancel_timeout("current_temperature");
+    return;
+  }
+
+  this->pending_temperature_ = state;
+  uint32_t elapsed = this->last_temperature_publish_.has_value() ? millis() - *this->last_temperature_publish_
+                                                                 : this->temperature_publish_interval_;
+  if (elapsed >= this->temperature_publish_interval_) {
+    this->cancel_timeout("current_temperature");
+    this->publish_current_temperature_();
+    return;
+  }
+  // Publish the latest reading once the minimum interval has passed
+  this->set_timeout("current_temperature", this->temperature_publish_interval_ - elapsed,
+                    [this]() { this->publish_current_temperature_(); });
+}
+
+void Daikin312Climate::run_local_control_(float measured) {
+  uint32_t now = millis();
+  uint32_t dt = this->last_control_update_.has_value() ? now - *this->last_control_update_ : 0;
+  this->last_control_update_ = now;
+
+  bool regulating = this->mode == climate::CLIMATE_MODE_HEAT || this->mode == climate::CLIMATE_MODE_COOL ||
+                    this->mode == climate::CLIMATE_MODE_HEAT_COOL;
+  if (!regulating || std::isnan(measured) || std::isnan(this->target_temperature)) {
+    this->control_integral_ = 0;
+    this->apply_setpoint_offset_(0);
+    return;
+  }
+
+  // The offset shifts the transmitted setpoint by the same sign in every mode:
+  // a room colder than the target asks for more heat or less cooling.
+  float error = this->target_temperature - measured;
+  float offset;
+  if (this->control_type_ == DAIKIN312_CONTROL_PI) {
+    this->control_integral_ += error * (dt / 1000.0f);
+    // Anti-windup: the integral term alone never exceeds the offset limit
+    if (this->control_ki_ > 0) {
+      float limit = this->control_max_offset_ / this->control_ki_;
+      this->control_integral_ = clamp(this->control_integral_, -limit, limit);
+    }
+    offset = this->control_kp_ * error + this->control_ki_ * this->control_integral_;
+  } else {
+    // Step the offset by one degree per change while outside the band
+    offset = this->setpoint_offset_;
+    if (error > this->control_hysteresis_) {
+      offset += 1;
+    } else if (error < -this->control_hysteresis_) {
+      offset -= 1;
     }
   }
+  this->apply_setpoint_offset_(clamp(offset, -this->control_max_offset_, this->control_max_offset_));
+}
+
+void Daikin312Climate::apply_setpoint_offset_(float offset) {
+  // The AC only takes whole degrees
+  offset = roundf(offset);
+  if (offset == this->setpoint_offset_)
+    return;
+  // Bound IR traffic; a reset to 0 (mode change) is applied immediately
+  if (offset != 0 && this->last_offset_change_.has_value() &&
+      millis() - *this->last_offset_change_ < this->control_min_interval_)
+    return;
+
+  ESP_LOGD(TAG, "Local control setpoint offset %+.0f -> %+.0f", this->setpoint_offset_, offset);
+  this->setpoint_offset_ = offset;
+  this->last_offset_change_ = millis();
+  this->set_target_temperature_();
+  this->schedule_transmit_(DAIKIN312_SOURCE_INTERNAL);
+}
+
+void Daikin312Climate::publish_current_temperature_() {
+  this->current_temperature = this->pending_temperature_;
+  this->last_temperature_publish_ = millis();
+  this->publish_state();
 }
 
 void Daikin312Climate::clear_powerful_mode_() {
   ESP_LOGD(TAG, "Powerful mode auto-expired after 20 minutes");
   this->powerful_mode_active_ = false;
-  this->ac_->setPowerful(false);
+  this->ir_state_.set_powerful(false);
   
   // Reset to previous fan mode or auto
   if (this->fan_mode.has_value()) {
-    this->set_fan_mode_(false);
+    this->set_fan_mode_();
   } else {
-    this->ac_->setFan(kDaikinFanAuto);
+    this->ir_state_.set_fan(DAIKIN312_FAN_AUTO);
     this->fan_mode = climate::CLIMATE_FAN_AUTO;
   }
   
@@ -123,7 +534,7 @@ climate::ClimateTraits Daikin312Climate::traits() {
       {climate::CLIMATE_FAN_AUTO, climate::CLIMATE_FAN_QUIET, climate::CLIMATE_FAN_LOW,
        climate::CLIMATE_FAN_MEDIUM, climate::CLIMATE_FAN_HIGH});
 
-  traits.set_supported_custom_fan_modes({"Max", "Turbo"});
+  traits.set_supported_custom_fan_modes({CUSTOM_FAN_MAX, CUSTOM_FAN_TURBO});
 
   traits.set_supported_swing_modes({climate::CLIMATE_SWING_OFF, climate::CLIMATE_SWING_BOTH,
                                     climate::CLIMATE_SWING_VERTICAL, climate::CLIMATE_SWING_HORIZONTAL});
@@ -135,9 +546,14 @@ climate::ClimateTraits Daikin312Climate::traits() {
 }
 
 void Daikin312Climate::control(const climate::ClimateCall &call) {
+  // Apply every requested field to the IR state first, then transmit a single
+  // frame so one ClimateCall never results in more than one IR transmission.
+  bool changed = false;
+
   if (call.get_mode().has_value()) {
     this->mode = *call.get_mode();
-    this->set_mode_(true);
+    this->set_mode_();
+    changed = true;
 
     // Fire on_turn_off trigger when mode is set to OFF (only from local control, not external)
     if (this->mode == climate::CLIMATE_MODE_OFF && this->turn_off_trigger_ != nullptr) {
@@ -147,37 +563,45 @@ void Daikin312Climate::control(const climate::ClimateCall &call) {
 
   if (call.get_target_temperature().has_value()) {
     this->target_temperature = *call.get_target_temperature();
-    this->set_target_temperature_(true);
+    this->set_target_temperature_();
+    changed = true;
   }
 
   if (call.has_custom_fan_mode() &&
       (this->get_custom_fan_mode().empty() || this->get_custom_fan_mode() != call.get_custom_fan_mode())) {
     this->fan_mode.reset();
     this->set_custom_fan_mode_(call.get_custom_fan_mode());
-    this->transmit_state_();
+    changed = true;
   }
 
   if (call.get_fan_mode().has_value() &&
       (!this->fan_mode.has_value() || this->fan_mode.value() != call.get_fan_mode().value())) {
     this->clear_custom_fan_mode_();
     this->fan_mode = *call.get_fan_mode();
-    this->set_fan_mode_(true);
+    this->set_fan_mode_();
+    changed = true;
   }
 
   if (call.get_swing_mode().has_value()) {
     this->swing_mode = *call.get_swing_mode();
-    this->set_swing_mode_(true);
+    this->set_swing_mode_();
+    changed = true;
   }
 
   if (call.has_custom_preset()) {
     this->preset.reset();
     this->set_custom_preset_(call.get_custom_preset());
-    this->transmit_state_();
+    changed = true;
   }
 
   if (call.get_preset().has_value()) {
     this->preset = *call.get_preset();
-    this->set_preset_(true);
+    this->set_preset_();
+    changed = true;
+  }
+
+  if (changed) {
+    this->schedule_transmit_(DAIKIN312_SOURCE_CLIMATE);
   }
 
   this->publish_state();
@@ -187,6 +611,67 @@ void Daikin312Climate::dump_config() {
   ESP_LOGCONFIG(TAG, "Daikin 312:");
   LOG_CLIMATE("", "IR Climate", this);
   LOG_PIN("  Step Pin: ", this->pin_);
+  ESP_LOGCONFIG(TAG, "  Transmitter: %s", this->bus_->is_blocking() ? "blocking" : "RMT (non-blocking)");
+  ESP_LOGCONFIG(TAG, "  Transmit priority: %u", this->transmit_priority_);
+  if (!this->bus_->is_blocking()) {
+    ESP_LOGCONFIG(TAG, "  Frame cache: %u entries, %" PRIu32 " hits, %" PRIu32 " misses",
+                  this->bus_->get_frame_cache_size(), this->bus_->get_frame_cache_hits(),
+                  this->bus_->get_frame_cache_misses());
+  }
+  if (this->sensor_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Current temperature deadband: %.2f", this->temperature_deadband_);
+    ESP_LOGCONFIG(TAG, "  Current temperature publish interval: %" PRIu32 " ms", this->temperature_publish_interval_);
+  }
+  if (this->local_control_) {
+    if (this->control_type_ == DAIKIN312_CONTROL_PI) {
+      ESP_LOGCONFIG(TAG, "  Local control: PI (kp %.2f, ki %.4f)", this->control_kp_, this->control_ki_);
+    } else {
+      ESP_LOGCONFIG(TAG, "  Local control: hysteresis (%.2f)", this->control_hysteresis_);
+    }
+    ESP_LOGCONFIG(TAG, "    Max offset: %.0f, min change interval: %" PRIu32 " ms, current offset: %+.0f",
+                  this->control_max_offset_, this->control_min_interval_, this->setpoint_offset_);
+  }
+  ESP_LOGCONFIG(TAG, "  Settings writes: %" PRIu32 " (%" PRIu32 " skipped as unchanged)", this->settings_writes_,
+                this->settings_writes_skipped_);
+  if (this->receiver_.is_enabled()) {
+    LOG_PIN("  Receiver Pin: ", this->receiver_pin_);
+    ESP_LOGCONFIG(TAG, "  Frames received: %" PRIu32 " decoded, %" PRIu32 " ignored",
+                  this->receiver_.get_frames_decoded(), this->receiver_.get_frames_invalid());
+  }
+  if (this->verify_) {
+    ESP_LOGCONFIG(TAG, "  Verify: timeout %" PRIu32 " ms, %u retries, backoff %" PRIu32 " ms", this->verify_timeout_,
+                  this->verify_max_retries_, this->verify_backoff_);
+    ESP_LOGCONFIG(TAG, "    Frames verified: %" PRIu32 ", retries: %" PRIu32 ", unverified: %" PRIu32,
+                  this->telemetry_.frames_verified, this->telemetry_.frame_retries,
+                  this->telemetry_.frames_unverified);
+  }
+  if (!this->schedule_.empty()) {
+    ESP_LOGCONFIG(TAG, "  Schedule: %u entries", this->schedule_.size());
+  }
+  ESP_LOGCONFIG(TAG, "  Coalesce window: %" PRIu32 " ms", this->coalesce_window_);
+  ESP_LOGCONFIG(TAG,
+                "  Frames sent: %" PRIu32 " (climate %" PRIu32 ", switch %" PRIu32 ", select %" PRIu32
+                ", restore %" PRIu32 ", internal %" PRIu32 ")",
+                this->telemetry_.frames_sent, this->telemetry_.frames_by_source[DAIKIN312_SOURCE_CLIMATE],
+                this->telemetry_.frames_by_source[DAIKIN312_SOURCE_SWITCH],
+                this->telemetry_.frames_by_source[DAIKIN312_SOURCE_SELECT],
+                this->telemetry_.frames_by_source[DAIKIN312_SOURCE_RESTORE],
+                this->telemetry_.frames_by_source[DAIKIN312_SOURCE_INTERNAL]);
+  ESP_LOGCONFIG(TAG, "  Time blocked sending: %" PRIu32 " ms",
+                static_cast<uint32_t>(this->telemetry_.blocked_us / 1000));
+  ESP_LOGCONFIG(TAG, "  Bytes encoded on this pin: %" PRIu32, this->bus_->get_bytes_encoded());
+  ESP_LOGCONFIG(TAG, "  State publishes: %" PRIu32, this->telemetry_.state_publishes);
+  ESP_LOGCONFIG(TAG, "  Frames coalesced: %" PRIu32, this->telemetry_.frames_coalesced);
+  if (this->resend_interval_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Resend interval: %" PRIu32 " ms", this->resend_interval_);
+  }
+  ESP_LOGCONFIG(TAG, "  Frames suppressed: %" PRIu32, this->telemetry_.frames_suppressed);
+  for (uint8_t i = 0; i < DAIKIN312_TIMER_COUNT; i++) {
+    if (this->timer_deadlines_[i].has_value()) {
+      ESP_LOGCONFIG(TAG, "  %s: %" PRId32 " s remaining", TIMER_NAMES[i],
+                    static_cast<int32_t>(*this->timer_deadlines_[i] - millis()) / 1000);
+    }
+  }
 
   ESP_LOGCONFIG(TAG, "  mode %s", LOG_STR_ARG(climate_mode_to_string(this->mode)));
   ESP_LOGCONFIG(TAG, "  target_temperature %f", this->target_temperature);
@@ -205,147 +690,97 @@ void Daikin312Climate::dump_config() {
   }
 }
 
-void Daikin312Climate::set_mode_(bool send) {
+void Daikin312Climate::set_mode_() {
   if (this->mode == climate::CLIMATE_MODE_OFF) {
-    this->ac_->setPower(false);
-  } else {
-    switch (this->mode) {
-      case climate::CLIMATE_MODE_COOL:
-        this->ac_->setMode(kDaikinCool);
-        break;
-      case climate::CLIMATE_MODE_HEAT:
-        this->ac_->setMode(kDaikinHeat);
-        break;
-      case climate::CLIMATE_MODE_HEAT_COOL:
-        this->ac_->setMode(kDaikinAuto);
-        break;
-      case climate::CLIMATE_MODE_FAN_ONLY:
-        this->ac_->setMode(kDaikinFan);
-        break;
-      case climate::CLIMATE_MODE_DRY:
-        this->ac_->setMode(kDaikinDry);
-        break;
-      case climate::CLIMATE_MODE_OFF:
-      default:
-        ESP_LOGW(TAG, "No Mode: %u", this->mode);
-    }
-    this->ac_->setPower(true);
+    this->ir_state_.set_power(false);
+    return;
   }
-  if (send) {
-    this->ac_->send();
+  if (this->mode >= sizeof(DAIKIN_MODES)) {
+    ESP_LOGW(TAG, "No Mode: %u", this->mode);
+    return;
   }
+  this->last_active_mode_ = this->mode;
+  this->ir_state_.set_mode(DAIKIN_MODES[this->mode]);
+  this->ir_state_.set_power(true);
 }
 
-void Daikin312Climate::set_target_temperature_(bool send) {
-  this->ac_->setTemp(this->target_temperature);
-  if (send) {
-    this->ac_->send();
-  }
+void Daikin312Climate::set_target_temperature_() {
+  this->ir_state_.set_temp(static_cast<uint8_t>(roundf(this->target_temperature + this->setpoint_offset_)));
 }
 
 void Daikin312Climate::set_custom_fan_mode_(const std::string &mode) {
-  if (str_equals_case_insensitive(mode, "Max")) {
-    this->ac_->setFan(kDaikinFanMax);
+  if (strcasecmp(mode.c_str(), CUSTOM_FAN_MAX) == 0) {
+    this->ir_state_.set_fan(DAIKIN312_FAN_MAX);
     this->powerful_mode_active_ = false;
-  } else if (str_equals_case_insensitive(mode, "Turbo")) {
-    this->ac_->setPowerful(true);
+    this->cancel_timeout("powerful");
+  } else if (strcasecmp(mode.c_str(), CUSTOM_FAN_TURBO) == 0) {
+    this->ir_state_.set_powerful(true);
     this->powerful_mode_active_ = true;
-    this->powerful_mode_start_time_ = millis();
+    // The AC unit turns powerful mode off by itself after 20 minutes
+    this->set_timeout("powerful", POWERFUL_MODE_DURATION_MS, [this]() { this->clear_powerful_mode_(); });
     ESP_LOGD(TAG, "Powerful mode activated - will auto-expire in 20 minutes");
   } else {
     ESP_LOGW(TAG, "Unknown Custom Fan Mode: %s", mode.c_str());
   }
 }
 
-void Daikin312Climate::set_fan_mode_(bool send) {
+void Daikin312Climate::set_fan_mode_() {
   if (!this->fan_mode.has_value()) {
     ESP_LOGD(TAG, "No Fan Mode set");
     return;
   }
 
-  switch (this->fan_mode.value()) {
-    case climate::CLIMATE_FAN_AUTO:
-      this->ac_->setFan(kDaikinFanAuto);
-      break;
-    case climate::CLIMATE_FAN_QUIET:
-      this->ac_->setQuiet(true);
-      break;
-    case climate::CLIMATE_FAN_LOW:
-      this->ac_->setFan(kDaikinFanMin);
-      break;
-    case climate::CLIMATE_FAN_MEDIUM:
-      this->ac_->setFan(kDaikinFanMed);
-      break;
-    case climate::CLIMATE_FAN_HIGH:
-      this->ac_->setFan(kDaikinFanMax);
-      break;
-    default:
-      ESP_LOGW(TAG, "Unsupported Fan Mode: %u", this->fan_mode.value());
-      break;
-  }
-
-  // Ensure quiet mode is disabled when switching to non-quiet fan modes
-  if (this->fan_mode.value() != climate::CLIMATE_FAN_QUIET) {
-    this->ac_->setQuiet(false);
+  climate::ClimateFanMode fan_mode = this->fan_mode.value();
+  if (fan_mode == climate::CLIMATE_FAN_QUIET) {
+    this->ir_state_.set_quiet(true);
+  } else {
+    if (fan_mode < sizeof(DAIKIN_FAN_SPEEDS) && DAIKIN_FAN_SPEEDS[fan_mode] != DAIKIN_FAN_NONE) {
+      this->ir_state_.set_fan(DAIKIN_FAN_SPEEDS[fan_mode]);
+    } else {
+      ESP_LOGW(TAG, "Unsupported Fan Mode: %u", fan_mode);
+    }
+    // Ensure quiet mode is disabled when switching to non-quiet fan modes
+    this->ir_state_.set_quiet(false);
   }
 
   // Disable powerful mode when switching to a regular fan mode
   if (this->powerful_mode_active_) {
-    this->ac_->setPowerful(false);
+    this->ir_state_.set_powerful(false);
     this->powerful_mode_active_ = false;
-  }
-
-  if (send) {
-    this->ac_->send();
+    this->cancel_timeout("powerful");
   }
 }
 
-void Daikin312Climate::set_swing_mode_(bool send) {
-  switch (this->swing_mode) {
-    case climate::CLIMATE_SWING_OFF:
-      this->ac_->setSwingVertical(kDaikin312SwingVOff);
-      this->ac_->setSwingHorizontal(kDaikin312SwingHOff);
-      break;
-    case climate::CLIMATE_SWING_BOTH:
-      this->ac_->setSwingVertical(kDaikin312SwingVAuto);
-      this->ac_->setSwingHorizontal(kDaikin312SwingHAuto);
-      break;
-    case climate::CLIMATE_SWING_VERTICAL:
-      this->ac_->setSwingVertical(kDaikin312SwingVAuto);
-      this->ac_->setSwingHorizontal(kDaikin312SwingHOff);
-      break;
-    case climate::CLIMATE_SWING_HORIZONTAL:
-      this->ac_->setSwingVertical(kDaikin312SwingVOff);
-      this->ac_->setSwingHorizontal(kDaikin312SwingHAuto);
-      break;
-  }
-
-  if (send) {
-    this->ac_->send();
-  }
+void Daikin312Climate::set_swing_mode_() {
+  if (this->swing_mode >= sizeof(DAIKIN_SWINGS) / sizeof(DAIKIN_SWINGS[0]))
+    return;
+  const DaikinSwing &swing = DAIKIN_SWINGS[this->swing_mode];
+  this->ir_state_.set_swing_vertical(swing.vertical);
+  this->ir_state_.set_swing_horizontal(swing.horizontal);
 }
 
-void Daikin312Climate::set_preset_(bool send) {
+void Daikin312Climate::set_preset_() {
   if (!this->preset.has_value()) {
     return;
   }
 
-  // Reset all preset-related settings first
-  this->ac_->setPowerful(false);
-  this->ac_->setEcono(false);
+  // Reset all preset-related settings first; quiet stays when it is the fan mode
+  this->ir_state_.set_powerful(false);
+  this->ir_state_.set_econo(false);
+  this->ir_state_.set_quiet(this->fan_mode.has_value() && this->fan_mode.value() == climate::CLIMATE_FAN_QUIET);
 
   switch (this->preset.value()) {
     case climate::CLIMATE_PRESET_BOOST:
-      this->ac_->setPowerful(true);
+      this->ir_state_.set_powerful(true);
       ESP_LOGD(TAG, "Preset: Boost (Powerful mode)");
       break;
     case climate::CLIMATE_PRESET_ECO:
-      this->ac_->setEcono(true);
+      this->ir_state_.set_econo(true);
       ESP_LOGD(TAG, "Preset: Eco");
       break;
     case climate::CLIMATE_PRESET_SLEEP:
       // Sleep mode typically uses quiet fan and comfort settings
-      this->ac_->setQuiet(true);
+      this->ir_state_.set_quiet(true);
       ESP_LOGD(TAG, "Preset: Sleep");
       break;
     case climate::CLIMATE_PRESET_NONE:
@@ -353,87 +788,246 @@ void Daikin312Climate::set_preset_(bool send) {
       ESP_LOGD(TAG, "Preset: None");
       break;
   }
+}
 
-  if (send) {
-    this->ac_->send();
+void Daikin312Climate::set_custom_preset_(const std::string & /*preset*/) {
+  // Custom presets not implemented for this model
+}
+
+void Daikin312Climate::finish_restore_() {
+  this->restoring_ = false;
+  uint32_t suppressed = this->telemetry_.frames_suppressed;
+  this->pending_sources_ |= 1 << DAIKIN312_SOURCE_RESTORE;
+  this->transmit_state_();
+  if (this->telemetry_.frames_suppressed != suppressed) {
+    ESP_LOGD(TAG, "Boot restore matches assumed AC state, nothing sent");
+  } else {
+    ESP_LOGD(TAG, "Boot restore sent as a single frame");
   }
 }
 
-void Daikin312Climate::set_custom_preset_(const std::string &preset) {
-  // Custom presets not implemented for this model
+void Daikin312Climate::schedule_transmit_(Daikin312TransmitSource source) {
+  this->schedule_settings_save_();
+  // Changes made while restoring are sent together by finish_restore_()
+  if (this->restoring_)
+    return;
+  this->pending_sources_ |= 1 << source;
+
+  if (this->coalesce_window_ == 0) {
+    this->transmit_state_();
+    return;
+  }
+
+  // The pending frame reads the IR state when it fires, so any change made
+  // inside the window is merged into it rather than sent on its own.
+  if (this->transmit_pending_) {
+    this->telemetry_.frames_coalesced++;
+    this->schedule_telemetry_publish_();
+    ESP_LOGV(TAG, "Change merged into pending frame (%" PRIu32 " saved)", this->telemetry_.frames_coalesced);
+    return;
+  }
+
+  this->transmit_pending_ = true;
+  this->set_timeout("transmit", this->coalesce_window_, [this]() {
+    this->transmit_pending_ = false;
+    this->transmit_state_();
+  });
 }
 
-void Daikin312Climate::transmit_state_() { this->ac_->send(); }
+void Daikin312Climate::transmit_state_(bool force) {
+  force |= this->force_after_wait_;
+  if (this->transmitting_) {
+    // Our previous frame is still on air; send the latest state once it has finished
+    this->force_after_wait_ = force;
+    this->resend_after_transmit_ = true;
+    return;
+  }
+  if (!this->bus_->acquire(this)) {
+    // Another unit is sending; on_bus_ready() sends the latest state on our turn
+    this->force_after_wait_ = force;
+    return;
+  }
+  this->force_after_wait_ = false;
+
+  const uint8_t *state = this->ir_state_.get_raw();
+  bool unchanged = this->last_sent_valid_ && memcmp(state, this->last_sent_state_, DAIKIN312_STATE_LENGTH) == 0;
+  if (!force && unchanged) {
+    this->telemetry_.frames_suppressed++;
+    this->pending_sources_ = 0;
+    this->schedule_telemetry_publish_();
+    ESP_LOGV(TAG, "IR state unchanged, frame suppressed (%" PRIu32 " total)", this->telemetry_.frames_suppressed);
+    this->bus_->release(this);
+    return;
+  }
+
+  memcpy(this->last_sent_state_, state, DAIKIN312_STATE_LENGTH);
+  this->last_sent_valid_ = true;
+  // A retry keeps counting attempts; a new state starts over
+  if (!unchanged || !this->verify_pending_)
+    this->verify_attempts_ = 0;
+  this->cancel_verify_();
+
+  uint32_t airtime;
+  uint32_t start = micros();
+  bool sent = this->bus_->transmit(state, &airtime);
+  this->telemetry_.blocked_us += micros() - start;
+  if (!sent) {
+    ESP_LOGW(TAG, "IR frame dropped, RMT transmission failed");
+    this->last_sent_valid_ = false;
+    this->bus_->release(this);
+    return;
+  }
+  this->record_frame_sent_();
+  this->transmitting_ = true;
+  if (airtime == 0) {
+    // A blocking send already took this loop iteration; keep the bus until
+    // the next one so units waiting for it don't send back to back
+    this->defer("transmit_done", [this]() { this->on_transmit_done_(); });
+    return;
+  }
+  this->set_timeout("transmit_done", airtime, [this]() { this->on_transmit_done_(); });
+}
+
+void Daikin312Climate::record_frame_sent_() {
+  this->telemetry_.frames_sent++;
+  for (uint8_t i = 0; i < DAIKIN312_SOURCE_COUNT; i++) {
+    if (this->pending_sources_ & (1 << i))
+      this->telemetry_.frames_by_source[i]++;
+  }
+  this->pending_sources_ = 0;
+  this->schedule_telemetry_publish_();
+}
+
+void Daikin312Climate::schedule_telemetry_publish_() {
+  this->defer("telemetry", [this]() {
+    const uint32_t values[DAIKIN312_TELEMETRY_COUNT] = {
+        this->telemetry_.frames_sent,
+        this->telemetry_.frames_coalesced,
+        this->telemetry_.frames_suppressed,
+        static_cast<uint32_t>(this->telemetry_.blocked_us / 1000),
+        this->telemetry_.frames_by_source[DAIKIN312_SOURCE_CLIMATE],
+        this->telemetry_.frames_by_source[DAIKIN312_SOURCE_SWITCH],
+        this->telemetry_.frames_by_source[DAIKIN312_SOURCE_SELECT],
+        this->telemetry_.frames_by_source[DAIKIN312_SOURCE_RESTORE],
+        this->telemetry_.frames_by_source[DAIKIN312_SOURCE_INTERNAL],
+        this->telemetry_.state_publishes,
+        this->telemetry_.frames_verified,
+        this->telemetry_.frame_retries,
+        this->telemetry_.frames_unverified,
+    };
+    for (uint8_t i = 0; i < DAIKIN312_TELEMETRY_COUNT; i++) {
+      if (this->telemetry_sensors_[i] != nullptr)
+        this->telemetry_sensors_[i]->publish_state(values[i]);
+    }
+  });
+}
+
+void Daikin312Climate::on_transmit_done_() {
+  if (this->bus_->is_busy()) {
+    this->set_timeout("transmit_done", 5, [this]() { this->on_transmit_done_(); });
+    return;
+  }
+
+  ESP_LOGV(TAG, "IR frame sent");
+  this->transmitting_ = false;
+  this->bus_->release(this);
+  this->start_verify_();
+  if (this->resend_after_transmit_) {
+    // Queues behind any other unit waiting for the bus
+    this->resend_after_transmit_ = false;
+    this->transmit_state_();
+  }
+}
+
+void Daikin312Climate::start_verify_() {
+  if (!this->verify_)
+    return;
+  // The receiver decodes the echo once the frame has ended
+  this->verify_pending_ = true;
+  this->set_timeout("verify", this->verify_timeout_, [this]() { this->on_verify_timeout_(); });
+}
+
+void Daikin312Climate::on_verify_timeout_() {
+  if (this->verify_attempts_ >= this->verify_max_retries_) {
+    this->verify_pending_ = false;
+    this->telemetry_.frames_unverified++;
+    this->schedule_telemetry_publish_();
+    ESP_LOGW(TAG, "IR frame not confirmed after %u retries", this->verify_attempts_);
+    return;
+  }
+
+  // Keep verify_pending_ set so the resend counts as another attempt
+  uint32_t backoff = this->verify_backoff_ << this->verify_attempts_;
+  this->verify_attempts_++;
+  this->telemetry_.frame_retries++;
+  this->schedule_telemetry_publish_();
+  ESP_LOGD(TAG, "No echo received, retry %u/%u in %" PRIu32 " ms", this->verify_attempts_, this->verify_max_retries_,
+           backoff);
+  this->set_timeout("verify_retry", backoff, [this]() {
+    this->pending_sources_ |= 1 << DAIKIN312_SOURCE_INTERNAL;
+    this->transmit_state_(true);
+  });
+}
+
+void Daikin312Climate::cancel_verify_() {
+  this->cancel_timeout("verify");
+  this->cancel_timeout("verify_retry");
+  this->verify_pending_ = false;
+}
+
+void Daikin312Climate::on_bus_ready() {
+  this->defer("bus_ready", [this]() { this->transmit_state_(); });
+}
 
 void Daikin312Climate::set_purify_enabled(bool enabled) {
+  this->changed_settings_ |= DAIKIN312_SETTING_PURIFY;
   this->purify_enabled_ = enabled;
-  if (this->ac_ != nullptr) {
-    this->ac_->setPurify(enabled);
-    this->ac_->send();
-  }
+  this->ir_state_.set_purify(enabled);
+  this->schedule_transmit_(DAIKIN312_SOURCE_SWITCH);
 }
 
 bool Daikin312Climate::get_purify() {
-  if (this->ac_ != nullptr) {
-    return this->ac_->getPurify();
-  }
-  return false;
+  return this->ir_state_.get_purify();
 }
 
 void Daikin312Climate::set_eye(bool enabled) {
-  if (this->ac_ != nullptr) {
-    this->ac_->setEye(enabled);
-    this->ac_->send();
-  }
+  this->changed_settings_ |= DAIKIN312_SETTING_EYE;
+  this->ir_state_.set_eye(enabled);
+  this->schedule_transmit_(DAIKIN312_SOURCE_SWITCH);
 }
 
 bool Daikin312Climate::get_eye() {
-  if (this->ac_ != nullptr) {
-    return this->ac_->getEye();
-  }
-  return false;
+  return this->ir_state_.get_eye();
 }
 
 void Daikin312Climate::set_eye_auto(bool enabled) {
-  if (this->ac_ != nullptr) {
-    this->ac_->setEyeAuto(enabled);
-    this->ac_->send();
-  }
+  this->changed_settings_ |= DAIKIN312_SETTING_EYE_AUTO;
+  this->ir_state_.set_eye_auto(enabled);
+  this->schedule_transmit_(DAIKIN312_SOURCE_SWITCH);
 }
 
 bool Daikin312Climate::get_eye_auto() {
-  if (this->ac_ != nullptr) {
-    return this->ac_->getEyeAuto();
-  }
-  return false;
+  return this->ir_state_.get_eye_auto();
 }
 
 void Daikin312Climate::set_light(uint8_t light) {
-  if (this->ac_ != nullptr) {
-    this->ac_->setLight(light);
-    this->ac_->send();
-  }
+  this->changed_settings_ |= DAIKIN312_SETTING_LIGHT;
+  this->ir_state_.set_light(light);
+  this->schedule_transmit_(DAIKIN312_SOURCE_SELECT);
 }
 
 uint8_t Daikin312Climate::get_light() {
-  if (this->ac_ != nullptr) {
-    return this->ac_->getLight();
-  }
-  return 3;  // Default to Off (kDaikinLightOff)
+  return this->ir_state_.get_light();
 }
 
 void Daikin312Climate::set_beep(uint8_t beep) {
-  if (this->ac_ != nullptr) {
-    this->ac_->setBeep(beep);
-    this->ac_->send();
-  }
+  this->changed_settings_ |= DAIKIN312_SETTING_BEEP;
+  this->ir_state_.set_beep(beep);
+  this->schedule_transmit_(DAIKIN312_SOURCE_SELECT);
 }
 
 uint8_t Daikin312Climate::get_beep() {
-  if (this->ac_ != nullptr) {
-    return this->ac_->getBeep();
-  }
-  return 3;  // Default to Off (kDaikinBeepOff)
+  return this->ir_state_.get_beep();
 }
 
 // External state sensor setters
@@ -453,33 +1047,41 @@ void Daikin312Climate::set_external_swing_mode_sensor(text_sensor::TextSensor *s
   this->external_swing_mode_sensor_ = sensor;
 }
 
+void Daikin312Climate::schedule_publish_() {
+  // One cloud update fires every external sensor in turn; publish once after
+  // all of them have been applied instead of once per sensor.
+  this->defer("publish", [this]() { this->publish_state(); });
+  this->schedule_settings_save_();
+}
+
+void Daikin312Climate::sync_external_state_() {
+  if (this->transmit_pending_) {
+    // The pending frame mixes in a local change the AC has not seen yet
+    this->last_sent_valid_ = false;
+    return;
+  }
+  // The AC already is in the reported state, so a later call that asks for
+  // the previously sent state is a change and must not be suppressed
+  memcpy(this->last_sent_state_, this->ir_state_.get_raw(), DAIKIN312_STATE_LENGTH);
+  this->last_sent_valid_ = true;
+}
+
 // External state update methods - update internal state without sending IR
 void Daikin312Climate::update_mode_from_external_(const std::string &mode) {
   ESP_LOGD(TAG, "External mode update: %s", mode.c_str());
 
-  climate::ClimateMode new_mode;
-  if (str_equals_case_insensitive(mode, "off")) {
-    new_mode = climate::CLIMATE_MODE_OFF;
-  } else if (str_equals_case_insensitive(mode, "cool")) {
-    new_mode = climate::CLIMATE_MODE_COOL;
-  } else if (str_equals_case_insensitive(mode, "heat")) {
-    new_mode = climate::CLIMATE_MODE_HEAT;
-  } else if (str_equals_case_insensitive(mode, "heat_cool") || str_equals_case_insensitive(mode, "auto")) {
-    new_mode = climate::CLIMATE_MODE_HEAT_COOL;
-  } else if (str_equals_case_insensitive(mode, "dry")) {
-    new_mode = climate::CLIMATE_MODE_DRY;
-  } else if (str_equals_case_insensitive(mode, "fan_only") || str_equals_case_insensitive(mode, "fan")) {
-    new_mode = climate::CLIMATE_MODE_FAN_ONLY;
-  } else {
+  auto new_mode = lookup_name(MODE_NAMES, mode.c_str());
+  if (!new_mode.has_value()) {
     ESP_LOGW(TAG, "Unknown external mode: %s", mode.c_str());
     return;
   }
 
-  if (this->mode != new_mode) {
-    this->mode = new_mode;
+  if (this->mode != *new_mode) {
+    this->mode = *new_mode;
     // Update internal AC state without sending IR
-    this->set_mode_(false);
-    this->publish_state();
+    this->set_mode_();
+    this->sync_external_state_();
+    this->schedule_publish_();
   }
 }
 
@@ -487,11 +1089,14 @@ void Daikin312Climate::update_temperature_from_external_(float temp) {
   ESP_LOGD(TAG, "External temperature update: %.1f", temp);
 
   if (!isnan(temp) && temp >= DEFAULT_TEMP_MIN && temp <= DEFAULT_TEMP_MAX) {
+    // The AC reports the transmitted setpoint, which includes the local control offset
+    temp -= this->setpoint_offset_;
     if (this->target_temperature != temp) {
       this->target_temperature = temp;
       // Update internal AC state without sending IR
-      this->set_target_temperature_(false);
-      this->publish_state();
+      this->set_target_temperature_();
+      this->sync_external_state_();
+      this->schedule_publish_();
     }
   } else {
     ESP_LOGW(TAG, "External temperature out of range: %.1f", temp);
@@ -501,61 +1106,37 @@ void Daikin312Climate::update_temperature_from_external_(float temp) {
 void Daikin312Climate::update_fan_mode_from_external_(const std::string &fan_mode) {
   ESP_LOGD(TAG, "External fan mode update: %s", fan_mode.c_str());
 
-  optional<climate::ClimateFanMode> new_fan_mode;
-
-  if (str_equals_case_insensitive(fan_mode, "auto")) {
-    new_fan_mode = climate::CLIMATE_FAN_AUTO;
-  } else if (str_equals_case_insensitive(fan_mode, "quiet") || str_equals_case_insensitive(fan_mode, "low")) {
-    // HA Daikin uses "low" for quiet mode
-    new_fan_mode = climate::CLIMATE_FAN_QUIET;
-  } else if (str_equals_case_insensitive(fan_mode, "1") || str_equals_case_insensitive(fan_mode, "min")) {
-    new_fan_mode = climate::CLIMATE_FAN_LOW;
-  } else if (str_equals_case_insensitive(fan_mode, "2") || str_equals_case_insensitive(fan_mode, "3") ||
-             str_equals_case_insensitive(fan_mode, "medium") || str_equals_case_insensitive(fan_mode, "mid")) {
-    new_fan_mode = climate::CLIMATE_FAN_MEDIUM;
-  } else if (str_equals_case_insensitive(fan_mode, "4") || str_equals_case_insensitive(fan_mode, "5") ||
-             str_equals_case_insensitive(fan_mode, "high") || str_equals_case_insensitive(fan_mode, "max")) {
-    new_fan_mode = climate::CLIMATE_FAN_HIGH;
-  } else {
+  auto new_fan_mode = lookup_name(FAN_MODE_NAMES, fan_mode.c_str());
+  if (!new_fan_mode.has_value()) {
     ESP_LOGW(TAG, "Unknown external fan mode: %s", fan_mode.c_str());
     return;
   }
 
-  if (new_fan_mode.has_value() && (!this->fan_mode.has_value() || this->fan_mode.value() != new_fan_mode.value())) {
+  if (!this->fan_mode.has_value() || this->fan_mode.value() != new_fan_mode.value()) {
     this->clear_custom_fan_mode_();
     this->fan_mode = new_fan_mode.value();
     // Update internal AC state without sending IR
-    this->set_fan_mode_(false);
-    this->publish_state();
+    this->set_fan_mode_();
+    this->sync_external_state_();
+    this->schedule_publish_();
   }
 }
 
 void Daikin312Climate::update_swing_mode_from_external_(const std::string &swing_mode) {
   ESP_LOGD(TAG, "External swing mode update: %s", swing_mode.c_str());
 
-  climate::ClimateSwingMode new_swing_mode;
-
-  if (str_equals_case_insensitive(swing_mode, "off")) {
-    new_swing_mode = climate::CLIMATE_SWING_OFF;
-  } else if (str_equals_case_insensitive(swing_mode, "both")) {
-    new_swing_mode = climate::CLIMATE_SWING_BOTH;
-  } else if (str_equals_case_insensitive(swing_mode, "vertical")) {
-    new_swing_mode = climate::CLIMATE_SWING_VERTICAL;
-  } else if (str_equals_case_insensitive(swing_mode, "horizontal")) {
-    new_swing_mode = climate::CLIMATE_SWING_HORIZONTAL;
-  } else if (str_equals_case_insensitive(swing_mode, "on")) {
-    // HA might report just "on" for swing, default to both
-    new_swing_mode = climate::CLIMATE_SWING_BOTH;
-  } else {
+  auto new_swing_mode = lookup_name(SWING_MODE_NAMES, swing_mode.c_str());
+  if (!new_swing_mode.has_value()) {
     ESP_LOGW(TAG, "Unknown external swing mode: %s", swing_mode.c_str());
     return;
   }
 
-  if (this->swing_mode != new_swing_mode) {
-    this->swing_mode = new_swing_mode;
+  if (this->swing_mode != *new_swing_mode) {
+    this->swing_mode = *new_swing_mode;
     // Update internal AC state without sending IR
-    this->set_swing_mode_(false);
-    this->publish_state();
+    this->set_swing_mode_();
+    this->sync_external_state_();
+    this->schedule_publish_();
   }
 }
 
@@ -3,17 +3,102 @@
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/preferences.h"
 #include "esphome/components/climate/climate.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/text_sensor/text_sensor.h"
+#ifdef USE_TIME
+#include "esphome/components/time/real_time_clock.h"
+#endif
 
-#include <ir_Daikin.h>
+#include "daikin_312_bus.h"
+#include "daikin_312_mappings.h"
+#include "daikin_312_protocol.h"
+#include "daikin_312_receiver.h"
+#include "daikin_312_schedule.h"
+#include "daikin_312_state.h"
 
 // Remote ARC466A58 DAIKIN312
 
 namespace esphome {
 namespace daikin_312 {
 
+enum Daikin312TimerType : uint8_t {
+  DAIKIN312_TIMER_ON = 0,
+  DAIKIN312_TIMER_OFF = 1,
+  DAIKIN312_TIMER_SLEEP = 2,
+};
+static const uint8_t DAIKIN312_TIMER_COUNT = 3;
+
+/// What caused a frame to be sent, for the per-source telemetry counters
+enum Daikin312TransmitSource : uint8_t {
+  DAIKIN312_SOURCE_CLIMATE = 0,   // climate call from Home Assistant or an automation
+  DAIKIN312_SOURCE_SWITCH = 1,    // purify/eye switches
+  DAIKIN312_SOURCE_SELECT = 2,    // light/beep selects
+  DAIKIN312_SOURCE_RESTORE = 3,   // boot restore
+  DAIKIN312_SOURCE_INTERNAL = 4,  // timers, schedule, local control and periodic resends
+};
+static const uint8_t DAIKIN312_SOURCE_COUNT = 5;
+
+/// Diagnostic values that can be exposed as sensors
+enum Daikin312TelemetryType : uint8_t {
+  DAIKIN312_TELEMETRY_FRAMES_SENT = 0,
+  DAIKIN312_TELEMETRY_FRAMES_COALESCED,
+  DAIKIN312_TELEMETRY_FRAMES_SUPPRESSED,
+  DAIKIN312_TELEMETRY_BLOCKED_TIME,
+  DAIKIN312_TELEMETRY_FRAMES_CLIMATE,
+  DAIKIN312_TELEMETRY_FRAMES_SWITCH,
+  DAIKIN312_TELEMETRY_FRAMES_SELECT,
+  DAIKIN312_TELEMETRY_FRAMES_RESTORE,
+  DAIKIN312_TELEMETRY_FRAMES_INTERNAL,
+  DAIKIN312_TELEMETRY_STATE_PUBLISHES,
+  DAIKIN312_TELEMETRY_FRAMES_VERIFIED,
+  DAIKIN312_TELEMETRY_FRAME_RETRIES,
+  DAIKIN312_TELEMETRY_FRAMES_UNVERIFIED,
+};
+static const uint8_t DAIKIN312_TELEMETRY_COUNT = 13;
+
+struct Daikin312Telemetry {
+  uint32_t frames_sent{0};
+  uint32_t frames_coalesced{0};   // merged into a pending frame
+  uint32_t frames_suppressed{0};  // identical to the last sent frame
+  uint64_t blocked_us{0};         // main loop time spent starting or sending frames; 32 bits wrap after 71 min
+  uint32_t frames_by_source[DAIKIN312_SOURCE_COUNT]{};
+  uint32_t state_publishes{0};  // climate state pushes to Home Assistant
+  uint32_t frames_received{0};  // state changes picked up from the remote control
+  uint32_t frames_verified{0};    // echo of our frame seen by the receiver
+  uint32_t frame_retries{0};      // resends after a missing echo
+  uint32_t frames_unverified{0};  // given up on after the last retry
+};
+
+/// Settings owned by the switches and selects, as bits of Daikin312Settings
+enum Daikin312Setting : uint8_t {
+  DAIKIN312_SETTING_EYE = 1 << 0,
+  DAIKIN312_SETTING_EYE_AUTO = 1 << 1,
+  DAIKIN312_SETTING_PURIFY = 1 << 2,
+  DAIKIN312_SETTING_LIGHT = 1 << 3,
+  DAIKIN312_SETTING_BEEP = 1 << 4,
+};
+static const uint8_t DAIKIN312_SETTING_UNSET = 0xFF;
+
+/// Everything restored on boot, saved as a single preference object
+struct Daikin312Settings {
+  uint8_t mode;
+  uint8_t target_temperature;
+  uint8_t fan_mode;  // DAIKIN312_SETTING_UNSET when a custom fan mode is active
+  uint8_t swing_mode;
+  uint8_t preset;  // DAIKIN312_SETTING_UNSET when no preset is set
+  uint8_t light;
+  uint8_t beep;
+  uint8_t flags;  // on/off settings, Daikin312Setting bits
+  uint8_t saved;  // Daikin312Setting bits that were set by a switch or select
+} __attribute__((packed));
+
+enum Daikin312ControlType : uint8_t {
+  DAIKIN312_CONTROL_HYSTERESIS = 0,
+  DAIKIN312_CONTROL_PI = 1,
+};
+
 class Daikin312Climate : public climate::Climate, public Component {
  public:
   void setup() override;
@@ -21,7 +106,57 @@ class Daikin312Climate : public climate::Climate, public Component {
   float get_setup_priority() const override { return setup_priority::DATA; }
 
   void set_sensor(sensor::Sensor *sensor) { this->sensor_ = sensor; }
+  void set_temperature_deadband(float temperature_deadband) { this->temperature_deadband_ = temperature_deadband; }
+  void set_temperature_publish_interval(uint32_t temperature_publish_interval) {
+    this->temperature_publish_interval_ = temperature_publish_interval;
+  }
   void set_pin(InternalGPIOPin *pin) { this->pin_ = pin; }
+  /// Optional IR receiver picking up frames sent by the physical remote
+  void set_receiver_pin(InternalGPIOPin *receiver_pin) { this->receiver_pin_ = receiver_pin; }
+  /// Expect the receiver to pick up every transmitted frame within `timeout`;
+  /// a missing echo is resent up to `max_retries` times, doubling `backoff`.
+  void set_verify(uint32_t timeout, uint8_t max_retries, uint32_t backoff) {
+    this->verify_ = true;
+    this->verify_timeout_ = timeout;
+    this->verify_max_retries_ = max_retries;
+    this->verify_backoff_ = backoff;
+  }
+#ifdef USE_TIME
+  void set_time(time::RealTimeClock *time) { this->time_ = time; }
+#endif
+  /// Add or replace the schedule entry at `minute` of the week (0 is Sunday 00:00).
+  /// Changes made after setup are saved and take effect at the next transition.
+  void add_schedule_entry(uint16_t minute, uint8_t mode, uint8_t target_temperature, uint8_t fan_mode);
+  void clear_schedule();
+  /// Regulate against `sensor` on-device by offsetting the transmitted setpoint.
+  void set_local_control(Daikin312ControlType type, float max_offset, uint32_t min_interval) {
+    this->local_control_ = true;
+    this->control_type_ = type;
+    this->control_max_offset_ = max_offset;
+    this->control_min_interval_ = min_interval;
+  }
+  void set_control_hysteresis(float hysteresis) { this->control_hysteresis_ = hysteresis; }
+  void set_control_gains(float kp, float ki) {
+    this->control_kp_ = kp;
+    this->control_ki_ = ki;
+  }
+  void set_coalesce_window(uint32_t coalesce_window) { this->coalesce_window_ = coalesce_window; }
+  void set_frame_cache_size(uint8_t frame_cache_size) { this->frame_cache_size_ = frame_cache_size; }
+  void set_resend_interval(uint32_t resend_interval) { this->resend_interval_ = resend_interval; }
+  void set_transmit_priority(uint8_t transmit_priority) { this->transmit_priority_ = transmit_priority; }
+  uint8_t get_transmit_priority() const { return this->transmit_priority_; }
+
+  /// Called by the shared bus when this unit's queued frame may be sent.
+  void on_bus_ready();
+
+  /// Number of IR frames avoided by merging changes into a pending transmission
+  uint32_t get_frames_coalesced() const { return this->telemetry_.frames_coalesced; }
+  /// Number of IR frames skipped because the state matched the last transmitted one
+  uint32_t get_frames_suppressed() const { return this->telemetry_.frames_suppressed; }
+  const Daikin312Telemetry &get_telemetry() const { return this->telemetry_; }
+  void set_telemetry_sensor(Daikin312TelemetryType type, sensor::Sensor *sensor) {
+    this->telemetry_sensors_[type] = sensor;
+  }
 
   // Automation triggers
   void set_turn_off_trigger(Trigger<> *trigger) { this->turn_off_trigger_ = trigger; }
@@ -43,6 +178,16 @@ class Daikin312Climate : public climate::Climate, public Component {
   uint8_t get_light();
   void set_beep(uint8_t beep);
   uint8_t get_beep();
+  /// True if the setting was restored from the saved settings
+  bool has_saved_setting(Daikin312Setting setting) const;
+  /// Called when switch and select values change outside of their control,
+  /// e.g. from a frame received from the remote
+  void add_on_settings_callback(std::function<void()> &&callback) { this->settings_callback_.add(std::move(callback)); }
+
+  /// Turn the AC on (ON), off (OFF), or run the sleep preset and then turn it
+  /// off (SLEEP) after the given duration. Restarting a timer replaces it.
+  void start_timer(Daikin312TimerType type, uint32_t duration_ms);
+  void cancel_timer(Daikin312TimerType type);
 
   void dump_config() override;
 
@@ -51,8 +196,37 @@ class Daikin312Climate : public climate::Climate, public Component {
   climate::ClimateTraits traits() override;
 
   sensor::Sensor *sensor_{nullptr};
-  IRDaikin312 *ac_{nullptr};
+  // Current temperature publishing: changes smaller than the deadband are
+  // ignored and the climate state is pushed at most once per interval
+  void update_current_temperature_(float state);
+  void publish_current_temperature_();
+  float temperature_deadband_{0.1f};
+  uint32_t temperature_publish_interval_{1000};
+  float pending_temperature_{NAN};
+  // Empty until the first publish, which is not delayed
+  optional<uint32_t> last_temperature_publish_;
+
+  // Local control loop; the offset is added to target_temperature when sent
+  void run_local_control_(float measured);
+  void apply_setpoint_offset_(float offset);
+  bool local_control_{false};
+  Daikin312ControlType control_type_{DAIKIN312_CONTROL_HYSTERESIS};
+  float control_hysteresis_{0.5f};
+  float control_kp_{1.0f};
+  float control_ki_{0.0f};
+  float control_max_offset_{2.0f};
+  uint32_t control_min_interval_{300000};
+  float control_integral_{0};
+  float setpoint_offset_{0};
+  optional<uint32_t> last_control_update_;
+  // Empty until the first offset change, which is applied without waiting
+  optional<uint32_t> last_offset_change_;
+  Daikin312State ir_state_;
   InternalGPIOPin *pin_{nullptr};
+  InternalGPIOPin *receiver_pin_{nullptr};
+  Daikin312Receiver receiver_;
+  CallbackManager<void()> settings_callback_;
+  void apply_received_state_(const uint8_t *state);
 //   bool mold_enabled_{true};
   bool purify_enabled_{true};
 
@@ -67,18 +241,89 @@ class Daikin312Climate : public climate::Climate, public Component {
   void update_temperature_from_external_(float temp);
   void update_fan_mode_from_external_(const std::string &fan_mode);
   void update_swing_mode_from_external_(const std::string &swing_mode);
-  void set_mode_(bool send);
-  void set_target_temperature_(bool send);
-  void set_fan_mode_(bool send);
-  void set_swing_mode_(bool send);
+  void sync_external_state_();
+  void schedule_publish_();
+  void set_mode_();
+  void set_target_temperature_();
+  void set_fan_mode_();
+  void set_swing_mode_();
   void set_custom_preset_(const std::string &preset);
-  void set_preset_(bool send);
+  void set_preset_();
   void set_custom_fan_mode_(const std::string &mode);
-  void transmit_state_();
+  void finish_restore_();
+  void schedule_transmit_(Daikin312TransmitSource source);
+  void transmit_state_(bool force = false);
+  void on_transmit_done_();
+
+  Daikin312Bus *bus_{nullptr};
+  uint8_t frame_cache_size_{6};
+  uint8_t transmit_priority_{0};
+  bool transmitting_{false};
+  bool resend_after_transmit_{false};
+  // A forced resend was requested while waiting for the bus
+  bool force_after_wait_{false};
   void clear_powerful_mode_();
-  uint32_t powerful_mode_start_time_{0};
+  void on_timer_expired_(Daikin312TimerType type);
   bool powerful_mode_active_{false};
 
+  // millis() deadline of each running timer, empty when inactive
+  optional<uint32_t> timer_deadlines_[DAIKIN312_TIMER_COUNT]{};
+  // Mode restored by the on timer
+  climate::ClimateMode last_active_mode_{climate::CLIMATE_MODE_HEAT_COOL};
+
+  // Set during boot until all switches and selects have applied their restored state
+  bool restoring_{true};
+
+  // Send scheduler: changes within the window are merged into one frame
+  uint32_t coalesce_window_{50};
+  bool transmit_pending_{false};
+  // Bitmask of Daikin312TransmitSource that changed the state since the last frame
+  uint8_t pending_sources_{0};
+
+  // Last transmitted state, identical frames are not sent again
+  uint8_t last_sent_state_[DAIKIN312_STATE_LENGTH];
+  bool last_sent_valid_{false};
+  uint32_t resend_interval_{0};
+
+  // Weekly schedule applied on-device at each transition
+  void schedule_changed_();
+  void schedule_next_transition_();
+  void run_schedule_();
+  void apply_schedule_entry_(const Daikin312ScheduleEntry &entry);
+  Daikin312Schedule schedule_;
+  bool schedule_loaded_{false};
+#ifdef USE_TIME
+  time::RealTimeClock *time_{nullptr};
+#endif
+
+  // Echo verification through the receiver
+  void start_verify_();
+  void on_verify_timeout_();
+  void cancel_verify_();
+  bool verify_{false};
+  uint32_t verify_timeout_{500};
+  uint8_t verify_max_retries_{3};
+  uint32_t verify_backoff_{250};
+  bool verify_pending_{false};
+  // Retries sent for the state in last_sent_state_
+  uint8_t verify_attempts_{0};
+
+  void record_frame_sent_();
+  void schedule_telemetry_publish_();
+  Daikin312Telemetry telemetry_;
+  sensor::Sensor *telemetry_sensors_[DAIKIN312_TELEMETRY_COUNT]{};
+
+  // Combined preference object; written after changes settle and only when changed
+  void apply_saved_settings_();
+  void schedule_settings_save_();
+  void commit_settings_();
+  ESPPreferenceObject settings_pref_;
+  Daikin312Settings saved_settings_{};
+  bool settings_loaded_{false};
+  uint8_t changed_settings_{0};
+  uint32_t settings_writes_{0};
+  uint32_t settings_writes_skipped_{0};
+
   // Automation triggers
   Trigger<> *turn_off_trigger_{nullptr};
 };
@@ -0,0 +1,169 @@
+#include "daikin_312_bus.h"
+#include "daikin_312.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace daikin_312 {
+
+static const char *const TAG = "daikin_312.bus";
+
+static std::vector<Daikin312Bus *> buses;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+Daikin312Bus *Daikin312Bus::get_or_create(InternalGPIOPin *pin, uint8_t frame_cache_size) {
+  for (auto *bus : buses) {
+    if (bus->get_pin() == pin->get_pin()) {
+      bus->add_frame_cache_size_(frame_cache_size);
+      return bus;
+    }
+  }
+
+  auto *bus = new Daikin312Bus(pin, frame_cache_size);  // NOLINT(cppcoreguidelines-owning-memory)
+  bus->setup_();
+  if (bus->is_blocking()) {
+    for (auto *other : buses) {
+      if (other->is_blocking()) {
+        bus->scheduler_ = other->scheduler_;
+        break;
+      }
+    }
+  }
+  buses.push_back(bus);
+  return bus;
+}
+
+Daikin312Bus::Daikin312Bus(InternalGPIOPin *pin, uint8_t frame_cache_size)
+    : pin_(pin), frame_cache_size_(frame_cache_size) {}
+
+void Daikin312Bus::setup_() {
+#ifdef USE_ESP32
+  // Prefer the non-blocking RMT path
+  this->rmt_ready_ = this->transmitter_.setup(this->pin_);
+  if (this->rmt_ready_)
+    return;
+  ESP_LOGW(TAG, "RMT unavailable on GPIO%u, falling back to blocking IR transmission", this->get_pin());
+#endif
+  this->soft_transmitter_.setup(this->pin_);
+}
+
+void Daikin312Bus::add_frame_cache_size_(uint8_t frame_cache_size) {
+  // The cache is shared by every unit on the pin and sized for the largest
+  // request. Units register in setup(), before the first frame allocates it.
+#ifdef USE_ESP32
+  if (this->frame_cache_ != nullptr)
+    return;
+#endif
+  this->frame_cache_size_ = std::max(this->frame_cache_size_, frame_cache_size);
+}
+
+bool Daikin312Bus::is_blocking() const {
+#ifdef USE_ESP32
+  return !this->rmt_ready_;
+#else
+  return true;
+#endif
+}
+
+bool Daikin312Bus::is_busy() const {
+#ifdef USE_ESP32
+  return this->rmt_ready_ && this->transmitter_.is_busy();
+#else
+  return false;
+#endif
+}
+
+bool Daikin312Bus::acquire(Daikin312Climate *unit) {
+  Daikin312Bus *scheduler = this->scheduler_;
+  if (scheduler->owner_ == unit)
+    return true;
+  if (scheduler->owner_ == nullptr) {
+    scheduler->owner_ = unit;
+    return true;
+  }
+
+  if (std::find(scheduler->queue_.begin(), scheduler->queue_.end(), unit) == scheduler->queue_.end()) {
+    scheduler->queue_.push_back(unit);
+    ESP_LOGV(TAG, "Bus busy, frame queued (%zu waiting)", scheduler->queue_.size());
+  }
+  return false;
+}
+
+void Daikin312Bus::release(Daikin312Climate *unit) {
+  Daikin312Bus *scheduler = this->scheduler_;
+  if (scheduler->owner_ != unit)
+    return;
+  scheduler->owner_ = nullptr;
+  if (scheduler->queue_.empty())
+    return;
+
+  // Highest priority first, oldest first among equal priorities
+  auto next = scheduler->queue_.begin();
+  for (auto it = next + 1; it != scheduler->queue_.end(); ++it) {
+    if ((*it)->get_transmit_priority() > (*next)->get_transmit_priority())
+      next = it;
+  }
+  Daikin312Climate *next_unit = *next;
+  scheduler->queue_.erase(next);
+
+  // Reserve the bus for the next unit; it sends from its own next loop
+  // iteration so a blocking frame never follows another in the same one.
+  scheduler->owner_ = next_unit;
+  next_unit->on_bus_ready();
+}
+
+bool Daikin312Bus::transmit(const uint8_t *state, uint32_t *airtime) {
+#ifdef USE_ESP32
+  if (this->rmt_ready_) {
+    *airtime = this->transmitter_.transmit(this->get_encoded_frame_(state));
+    return *airtime != 0;
+  }
+#endif
+  this->soft_transmitter_.send(state);
+  this->bytes_encoded_ += DAIKIN312_STATE_LENGTH;
+  *airtime = 0;
+  return true;
+}
+
+#ifdef USE_ESP32
+static uint32_t hash_state(const uint8_t *state) {
+  uint32_t hash = 2166136261UL;
+  for (uint16_t i = 0; i < DAIKIN312_STATE_LENGTH; i++) {
+    hash ^= state[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+const Daikin312Frame *Daikin312Bus::get_encoded_frame_(const uint8_t *state) {
+  uint32_t hash = hash_state(state);
+  this->frame_cache_tick_++;
+  if (this->frame_cache_ == nullptr)
+    this->frame_cache_ = new FrameCacheEntry[this->frame_cache_size_];  // NOLINT(cppcoreguidelines-owning-memory)
+
+  // Only called while the transmitter is idle, so the least recently used
+  // entry is never the frame currently on air.
+  FrameCacheEntry *victim = &this->frame_cache_[0];
+  for (uint8_t i = 0; i < this->frame_cache_size_; i++) {
+    FrameCacheEntry *entry = &this->frame_cache_[i];
+    if (entry->last_used != 0 && entry->hash == hash && memcmp(entry->state, state, DAIKIN312_STATE_LENGTH) == 0) {
+      entry->last_used = this->frame_cache_tick_;
+      this->frame_cache_hits_++;
+      return &entry->frame;
+    }
+    if (entry->last_used < victim->last_used)
+      victim = entry;
+  }
+
+  this->frame_cache_misses_++;
+  this->bytes_encoded_ += DAIKIN312_STATE_LENGTH;
+  memcpy(victim->state, state, DAIKIN312_STATE_LENGTH);
+  victim->hash = hash;
+  victim->last_used = this->frame_cache_tick_;
+  Daikin312Transmitter::encode(state, &victim->frame);
+  return &victim->frame;
+}
+#endif
+
+}  // namespace daikin_312
+}  // namespace esphome
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+
+#include "esphome/core/hal.h"
+#include "daikin_312_protocol.h"
+#include "daikin_312_transmitter.h"
+
+namespace esphome {
+namespace daikin_312 {
+
+class Daikin312Climate;
+
+/// The IR output shared by every Daikin312Climate on the same pin. Only one
+/// unit owns the bus at a time; the others queue and are handed the bus in
+/// priority order once the frame on air has finished.
+///
+/// Buses with a blocking transmitter share one queue across all pins, so at
+/// most one blocking frame is sent per main loop iteration.
+class Daikin312Bus {
+ public:
+  /// Bus for the given pin, created on first use. Its frame cache holds the
+  /// largest `frame_cache_size` of the units on the pin.
+  static Daikin312Bus *get_or_create(InternalGPIOPin *pin, uint8_t frame_cache_size);
+
+  /// Take the bus for sending. Returns false when another unit owns it; the
+  /// unit is then queued and its on_bus_ready() is called when it is its turn.
+  bool acquire(Daikin312Climate *unit);
+  /// Hand the bus to the next queued unit.
+  void release(Daikin312Climate *unit);
+
+  /// Start sending a state. On success `airtime` is set to the time in
+  /// milliseconds until the frame has left the pin (0 for blocking sends).
+  bool transmit(const uint8_t *state, uint32_t *airtime);
+  /// True while a non-blocking frame is still on air.
+  bool is_busy() const;
+
+  bool is_blocking() const;
+  uint8_t get_pin() const { return this->pin_->get_pin(); }
+  size_t get_queue_length() const { return this->scheduler_->queue_.size(); }
+  uint32_t get_frame_cache_hits() const { return this->frame_cache_hits_; }
+  uint32_t get_frame_cache_misses() const { return this->frame_cache_misses_; }
+  uint8_t get_frame_cache_size() const { return this->frame_cache_size_; }
+  /// State bytes turned into pulses, by the RMT encoder or the software sender
+  uint32_t get_bytes_encoded() const { return this->bytes_encoded_; }
+  const Daikin312SoftTransmitter &get_soft_transmitter() const { return this->soft_transmitter_; }
+
+ protected:
+  explicit Daikin312Bus(InternalGPIOPin *pin, uint8_t frame_cache_size);
+  void setup_();
+  void add_frame_cache_size_(uint8_t frame_cache_size);
+
+  InternalGPIOPin *pin_;
+  // Bus holding the owner and queue; itself for RMT buses, the first blocking bus otherwise
+  Daikin312Bus *scheduler_{this};
+  Daikin312Climate *owner_{nullptr};
+  std::vector<Daikin312Climate *> queue_;
+
+  Daikin312SoftTransmitter soft_transmitter_;
+#ifdef USE_ESP32
+  // Pre-encoded frames of recently sent states, least recently used is replaced
+  struct FrameCacheEntry {
+    uint8_t state[DAIKIN312_STATE_LENGTH];
+    uint32_t hash{0};
+    uint32_t last_used{0};  // 0 marks an empty entry
+    Daikin312Frame frame;
+  };
+
+  const Daikin312Frame *get_encoded_frame_(const uint8_t *state);
+
+  Daikin312Transmitter transmitter_;
+  bool rmt_ready_{false};
+  FrameCacheEntry *frame_cache_{nullptr};  // allocated with the first frame
+  uint32_t frame_cache_tick_{0};
+#endif
+  uint8_t frame_cache_size_;
+  uint32_t frame_cache_hits_{0};
+  uint32_t frame_cache_misses_{0};
+  uint32_t bytes_encoded_{0};
+};
+
+}  // namespace daikin_312
+}  // namespace esphome
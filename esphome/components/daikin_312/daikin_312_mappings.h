@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <strings.h>
+
+#include "esphome/core/helpers.h"
+#include "esphome/components/climate/climate_mode.h"
+
+#include "daikin_312_protocol.h"
+
+namespace esphome {
+namespace daikin_312 {
+
+// Translation tables between ESPHome/Home Assistant values and the Daikin312
+// IR state, shared by the climate, switch and select classes.
+
+/// Light level as encoded in the IR state
+enum Daikin312Light : uint8_t {
+  DAIKIN312_LIGHT_BRIGHT = 1,
+  DAIKIN312_LIGHT_DIM = 2,
+  DAIKIN312_LIGHT_OFF = 3,
+};
+
+/// Beep level as encoded in the IR state
+enum Daikin312Beep : uint8_t {
+  DAIKIN312_BEEP_QUIET = 1,
+  DAIKIN312_BEEP_LOUD = 2,
+  DAIKIN312_BEEP_OFF = 3,
+};
+
+// Select option values, in the option order declared by select/__init__.py
+static constexpr size_t OPTION_COUNT = 3;
+static constexpr uint8_t LIGHT_OPTION_VALUES[OPTION_COUNT] = {DAIKIN312_LIGHT_OFF, DAIKIN312_LIGHT_DIM,
+                                                              DAIKIN312_LIGHT_BRIGHT};
+static constexpr uint8_t BEEP_OPTION_VALUES[OPTION_COUNT] = {DAIKIN312_BEEP_OFF, DAIKIN312_BEEP_QUIET,
+                                                             DAIKIN312_BEEP_LOUD};
+
+/// Option index of a light/beep value; unknown values map to Off (index 0).
+constexpr size_t option_index(const uint8_t *values, uint8_t value) {
+  for (size_t i = 0; i < OPTION_COUNT; i++) {
+    if (values[i] == value)
+      return i;
+  }
+  return 0;
+}
+
+/// True when `value` is one of the light/beep option values.
+constexpr bool is_option_value(const uint8_t *values, uint8_t value) {
+  for (size_t i = 0; i < OPTION_COUNT; i++) {
+    if (values[i] == value)
+      return true;
+  }
+  return false;
+}
+
+static constexpr const char *CUSTOM_FAN_MAX = "Max";
+static constexpr const char *CUSTOM_FAN_TURBO = "Turbo";
+
+/// Daikin mode for each climate::ClimateMode, indexed by the enum value. OFF is
+/// sent as power off and keeps whatever mode was set before.
+static constexpr uint8_t DAIKIN_MODES[] = {
+    DAIKIN312_MODE_AUTO,  // CLIMATE_MODE_OFF
+    DAIKIN312_MODE_AUTO,  // CLIMATE_MODE_HEAT_COOL
+    DAIKIN312_MODE_COOL,  // CLIMATE_MODE_COOL
+    DAIKIN312_MODE_HEAT,  // CLIMATE_MODE_HEAT
+    DAIKIN312_MODE_FAN,   // CLIMATE_MODE_FAN_ONLY
+    DAIKIN312_MODE_DRY,   // CLIMATE_MODE_DRY
+};
+static_assert(climate::CLIMATE_MODE_HEAT_COOL == 1 && climate::CLIMATE_MODE_DRY == 5,
+              "DAIKIN_MODES is indexed by climate::ClimateMode");
+
+/// Daikin fan speed for each climate::ClimateFanMode, indexed by the enum value.
+/// Quiet is a separate flag in the IR state and has no fan speed of its own.
+static constexpr uint8_t DAIKIN_FAN_NONE = 0;
+static constexpr uint8_t DAIKIN_FAN_SPEEDS[] = {
+    DAIKIN_FAN_NONE,     // CLIMATE_FAN_ON
+    DAIKIN_FAN_NONE,     // CLIMATE_FAN_OFF
+    DAIKIN312_FAN_AUTO,  // CLIMATE_FAN_AUTO
+    DAIKIN312_FAN_MIN,   // CLIMATE_FAN_LOW
+    DAIKIN312_FAN_MED,   // CLIMATE_FAN_MEDIUM
+    DAIKIN312_FAN_MAX,   // CLIMATE_FAN_HIGH
+};
+static_assert(climate::CLIMATE_FAN_AUTO == 2 && climate::CLIMATE_FAN_HIGH == 5,
+              "DAIKIN_FAN_SPEEDS is indexed by climate::ClimateFanMode");
+
+struct DaikinSwing {
+  uint8_t vertical;
+  uint8_t horizontal;
+};
+
+/// Vane positions for each climate::ClimateSwingMode, indexed by the enum value
+static constexpr DaikinSwing DAIKIN_SWINGS[] = {
+    {DAIKIN312_SWING_V_OFF, DAIKIN312_SWING_H_OFF},    // CLIMATE_SWING_OFF
+    {DAIKIN312_SWING_V_AUTO, DAIKIN312_SWING_H_AUTO},  // CLIMATE_SWING_BOTH
+    {DAIKIN312_SWING_V_AUTO, DAIKIN312_SWING_H_OFF},   // CLIMATE_SWING_VERTICAL
+    {DAIKIN312_SWING_V_OFF, DAIKIN312_SWING_H_AUTO},   // CLIMATE_SWING_HORIZONTAL
+};
+static_assert(climate::CLIMATE_SWING_OFF == 0 && climate::CLIMATE_SWING_HORIZONTAL == 3,
+              "DAIKIN_SWINGS is indexed by climate::ClimateSwingMode");
+
+/// climate::ClimateMode for a Daikin mode; auto maps to HEAT_COOL.
+inline climate::ClimateMode climate_mode_from_daikin(uint8_t mode) {
+  for (size_t i = climate::CLIMATE_MODE_HEAT_COOL; i < sizeof(DAIKIN_MODES); i++) {
+    if (DAIKIN_MODES[i] == mode)
+      return static_cast<climate::ClimateMode>(i);
+  }
+  return climate::CLIMATE_MODE_HEAT_COOL;
+}
+
+/// climate::ClimateFanMode for a Daikin fan speed; the intermediate speeds
+/// 2 and 4 have no ESPHome equivalent and map away from medium, to low and high.
+inline climate::ClimateFanMode climate_fan_mode_from_daikin(uint8_t speed) {
+  for (size_t i = 0; i < sizeof(DAIKIN_FAN_SPEEDS); i++) {
+    if (DAIKIN_FAN_SPEEDS[i] != DAIKIN_FAN_NONE && DAIKIN_FAN_SPEEDS[i] == speed)
+      return static_cast<climate::ClimateFanMode>(i);
+  }
+  if (speed == DAIKIN312_FAN_QUIET)
+    return climate::CLIMATE_FAN_QUIET;
+  return speed < DAIKIN312_FAN_MED ? climate::CLIMATE_FAN_LOW : climate::CLIMATE_FAN_HIGH;
+}
+
+/// climate::ClimateSwingMode for a pair of vane positions; any fixed vertical
+/// position other than off counts as not swinging.
+inline climate::ClimateSwingMode climate_swing_mode_from_daikin(uint8_t vertical, uint8_t horizontal) {
+  for (size_t i = 0; i < sizeof(DAIKIN_SWINGS) / sizeof(DAIKIN_SWINGS[0]); i++) {
+    if (DAIKIN_SWINGS[i].vertical == vertical && DAIKIN_SWINGS[i].horizontal == horizontal)
+      return static_cast<climate::ClimateSwingMode>(i);
+  }
+  bool swing_h = horizontal == DAIKIN312_SWING_H_AUTO;
+  return swing_h ? climate::CLIMATE_SWING_HORIZONTAL : climate::CLIMATE_SWING_OFF;
+}
+
+template<typename T> struct NameMapping {
+  const char *name;
+  T value;
+};
+
+/// Mode names reported by the Home Assistant Daikin integration
+static constexpr NameMapping<climate::ClimateMode> MODE_NAMES[] = {
+    {"off", climate::CLIMATE_MODE_OFF},
+    {"cool", climate::CLIMATE_MODE_COOL},
+    {"heat", climate::CLIMATE_MODE_HEAT},
+    {"heat_cool", climate::CLIMATE_MODE_HEAT_COOL},
+    {"auto", climate::CLIMATE_MODE_HEAT_COOL},
+    {"dry", climate::CLIMATE_MODE_DRY},
+    {"fan_only", climate::CLIMATE_MODE_FAN_ONLY},
+    {"fan", climate::CLIMATE_MODE_FAN_ONLY},
+};
+
+/// Fan mode names reported by the Home Assistant Daikin integration. HA uses
+/// "low" for quiet and numbered speeds 1-5 for the fixed speeds.
+static constexpr NameMapping<climate::ClimateFanMode> FAN_MODE_NAMES[] = {
+    {"auto", climate::CLIMATE_FAN_AUTO},     {"quiet", climate::CLIMATE_FAN_QUIET},
+    {"low", climate::CLIMATE_FAN_QUIET},     {"1", climate::CLIMATE_FAN_LOW},
+    {"min", climate::CLIMATE_FAN_LOW},       {"2", climate::CLIMATE_FAN_MEDIUM},
+    {"3", climate::CLIMATE_FAN_MEDIUM},      {"medium", climate::CLIMATE_FAN_MEDIUM},
+    {"mid", climate::CLIMATE_FAN_MEDIUM},    {"4", climate::CLIMATE_FAN_HIGH},
+    {"5", climate::CLIMATE_FAN_HIGH},        {"high", climate::CLIMATE_FAN_HIGH},
+    {"max", climate::CLIMATE_FAN_HIGH},
+};
+
+/// Swing mode names reported by the Home Assistant Daikin integration; a bare
+/// "on" is treated as swinging in both directions.
+static constexpr NameMapping<climate::ClimateSwingMode> SWING_MODE_NAMES[] = {
+    {"off", climate::CLIMATE_SWING_OFF},
+    {"both", climate::CLIMATE_SWING_BOTH},
+    {"vertical", climate::CLIMATE_SWING_VERTICAL},
+    {"horizontal", climate::CLIMATE_SWING_HORIZONTAL},
+    {"on", climate::CLIMATE_SWING_BOTH},
+};
+
+/// Case-insensitive lookup of a name without building temporary strings.
+template<typename T, size_t N> optional<T> lookup_name(const NameMapping<T> (&table)[N], const char *name) {
+  for (const auto &entry : table) {
+    if (strcasecmp(entry.name, name) == 0)
+      return entry.value;
+  }
+  return {};
+}
+
+}  // namespace daikin_312
+}  // namespace esphome
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace daikin_312 {
+
+// Framing of the ARC466A58 (Daikin312) IR protocol, as sent by
+// IRremoteESP8266's sendDaikin312(): a leader pulse followed by two sections of
+// 20 and 19 bytes. Each section has its own header, sends its bytes LSB first
+// and ends with a footer mark and a long gap. All durations in microseconds.
+static constexpr uint32_t DAIKIN312_CARRIER_FREQUENCY = 36700;
+
+static constexpr uint16_t DAIKIN312_STATE_LENGTH = 39;
+static constexpr uint16_t DAIKIN312_SECTION1_LENGTH = 20;
+static constexpr uint16_t DAIKIN312_SECTION2_LENGTH = DAIKIN312_STATE_LENGTH - DAIKIN312_SECTION1_LENGTH;
+
+static constexpr uint16_t DAIKIN312_LEADER_MARK = 10024;
+static constexpr uint16_t DAIKIN312_LEADER_SPACE = 25180;
+static constexpr uint16_t DAIKIN312_HEADER_MARK = 3500;
+static constexpr uint16_t DAIKIN312_HEADER_SPACE = 1728;
+static constexpr uint16_t DAIKIN312_BIT_MARK = 460;
+static constexpr uint16_t DAIKIN312_ONE_SPACE = 1270;
+static constexpr uint16_t DAIKIN312_ZERO_SPACE = 420;
+static constexpr uint32_t DAIKIN312_GAP = DAIKIN312_LEADER_MARK + DAIKIN312_LEADER_SPACE;
+
+// Operating modes as encoded in the state
+static constexpr uint8_t DAIKIN312_MODE_AUTO = 0;
+static constexpr uint8_t DAIKIN312_MODE_DRY = 2;
+static constexpr uint8_t DAIKIN312_MODE_COOL = 3;
+static constexpr uint8_t DAIKIN312_MODE_HEAT = 4;
+static constexpr uint8_t DAIKIN312_MODE_FAN = 6;
+
+// Fan speeds; fixed speeds run from MIN to MAX, AUTO and QUIET are special values
+static constexpr uint8_t DAIKIN312_FAN_MIN = 1;
+static constexpr uint8_t DAIKIN312_FAN_MED = 3;
+static constexpr uint8_t DAIKIN312_FAN_MAX = 5;
+static constexpr uint8_t DAIKIN312_FAN_AUTO = 10;
+static constexpr uint8_t DAIKIN312_FAN_QUIET = 11;
+
+// Vane positions
+static constexpr uint8_t DAIKIN312_SWING_V_OFF = 0x0;
+static constexpr uint8_t DAIKIN312_SWING_V_AUTO = 0xF;
+static constexpr uint8_t DAIKIN312_SWING_H_OFF = 0xBE;
+static constexpr uint8_t DAIKIN312_SWING_H_AUTO = 0xBF;
+
+// Setpoint range in Celsius; cooling does not go below COOL_MIN_TEMP
+static constexpr uint8_t DAIKIN312_MIN_TEMP = 10;
+static constexpr uint8_t DAIKIN312_COOL_MIN_TEMP = 18;
+static constexpr uint8_t DAIKIN312_MAX_TEMP = 32;
+
+// Number of mark/space pairs in one frame: leader, then per section a header,
+// one pair per bit and the footer.
+static constexpr uint16_t DAIKIN312_FRAME_PAIRS = 1 + (1 + DAIKIN312_SECTION1_LENGTH * 8 + 1) +
+                                                  (1 + DAIKIN312_SECTION2_LENGTH * 8 + 1);
+
+}  // namespace daikin_312
+}  // namespace esphome
@@ -0,0 +1,101 @@
+#include "daikin_312_receiver.h"
+#include "daikin_312_state.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace daikin_312 {
+
+static const char *const TAG = "daikin_312.receiver";
+
+// Receiver modules stretch marks and shorten spaces by up to ~150 us
+static const uint32_t MARK_MIN = 150;
+static const uint32_t MARK_MAX = 900;
+static const uint32_t BIT_SPACE_THRESHOLD = (DAIKIN312_ONE_SPACE + DAIKIN312_ZERO_SPACE) / 2;
+
+static bool matches(uint32_t duration, uint32_t expected) {
+  // 25% tolerance
+  return duration >= expected - expected / 4 && duration <= expected + expected / 4;
+}
+
+void IRAM_ATTR Daikin312ReceiverStore::gpio_intr(Daikin312ReceiverStore *arg) {
+  const uint32_t now = micros();
+  uint16_t count = arg->count;
+  if (count >= DAIKIN312_RECEIVER_EDGES) {
+    arg->overflow = true;
+  } else {
+    arg->edges[count] = now;
+    arg->count = count + 1;
+  }
+  arg->last_edge = now;
+  if (count == 0)
+    arg->component->enable_loop_soon_any_context();
+}
+
+void Daikin312Receiver::setup(InternalGPIOPin *pin, Component *component) {
+  this->pin_ = pin;
+  this->pin_->setup();
+  this->store_ = new Daikin312ReceiverStore();  // NOLINT(cppcoreguidelines-owning-memory)
+  this->store_->component = component;
+  this->pin_->attach_interrupt(Daikin312ReceiverStore::gpio_intr, this->store_, gpio::INTERRUPT_ANY_EDGE);
+}
+
+bool Daikin312Receiver::poll(uint8_t *state) {
+  if (this->store_ == nullptr)
+    return false;
+  uint16_t count = this->store_->count;
+  if (count == 0 || micros() - this->store_->last_edge < DAIKIN312_RECEIVER_IDLE_US)
+    return false;
+
+  // The line is idle, so the interrupt does not touch the buffer until reset
+  bool overflow = this->store_->overflow;
+  bool decoded = !overflow && decode(this->store_->edges, count, state) && Daikin312State::is_valid(state);
+  {
+    InterruptLock lock;
+    this->store_->count = 0;
+    this->store_->overflow = false;
+  }
+
+  if (!decoded) {
+    // Captures from other remotes end up here as well
+    this->frames_invalid_++;
+    ESP_LOGV(TAG, "Ignoring capture of %u edges%s", count, overflow ? " (overflow)" : "");
+    return false;
+  }
+  this->frames_decoded_++;
+  ESP_LOGD(TAG, "Received frame: %s", format_hex_pretty(state, DAIKIN312_STATE_LENGTH).c_str());
+  return true;
+}
+
+bool Daikin312Receiver::decode(const volatile uint32_t *edges, uint16_t count, uint8_t *state) {
+  uint16_t edge = 0;
+  auto duration = [edges](uint16_t index) -> uint32_t { return edges[index + 1] - edges[index]; };
+
+  uint16_t offset = 0;
+  for (uint16_t length : {DAIKIN312_SECTION1_LENGTH, DAIKIN312_SECTION2_LENGTH}) {
+    // Skip the leader or gap up to the section header
+    while (edge + 2 < count && !(matches(duration(edge), DAIKIN312_HEADER_MARK) &&
+                                 matches(duration(edge + 1), DAIKIN312_HEADER_SPACE)))
+      edge++;
+    edge += 2;
+    // Every bit needs a mark and a space, the footer one more mark
+    if (edge + length * 16 + 1 >= count)
+      return false;
+
+    for (uint16_t i = 0; i < length; i++) {
+      uint8_t data = 0;
+      for (uint8_t bit = 0; bit < 8; bit++, edge += 2) {
+        uint32_t mark = duration(edge);
+        if (mark < MARK_MIN || mark > MARK_MAX)
+          return false;
+        if (duration(edge + 1) > BIT_SPACE_THRESHOLD)
+          data |= 1 << bit;
+      }
+      state[offset++] = data;
+    }
+  }
+  return true;
+}
+
+}  // namespace daikin_312
+}  // namespace esphome
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "daikin_312_protocol.h"
+
+namespace esphome {
+namespace daikin_312 {
+
+// Edges in one frame: leader, then per section a header, two per bit and the footer
+static constexpr uint16_t DAIKIN312_RECEIVER_EDGES = DAIKIN312_FRAME_PAIRS * 2 + 16;
+// Silence after the last edge that ends a capture; longer than the section gap
+static constexpr uint32_t DAIKIN312_RECEIVER_IDLE_US = DAIKIN312_GAP + 15000;
+
+/// State shared with the edge interrupt.
+struct Daikin312ReceiverStore {
+  static void gpio_intr(Daikin312ReceiverStore *arg);
+
+  volatile uint32_t edges[DAIKIN312_RECEIVER_EDGES];  // micros() of each edge
+  volatile uint16_t count{0};
+  volatile uint32_t last_edge{0};
+  volatile bool overflow{false};
+  Component *component{nullptr};
+};
+
+/// Captures frames from an IR receiver module by timestamping every edge in
+/// an interrupt and decodes them once the line has been idle. The interrupt
+/// wakes the owning component's loop, which only needs to run while a capture
+/// is in progress.
+class Daikin312Receiver {
+ public:
+  void setup(InternalGPIOPin *pin, Component *component);
+  bool is_enabled() const { return this->store_ != nullptr; }
+
+  /// True when no capture is in progress.
+  bool is_idle() const { return this->store_ == nullptr || this->store_->count == 0; }
+
+  /// Decode a finished capture into `state`. Returns false while a capture is
+  /// still in progress, or if the capture was not a valid Daikin312 frame.
+  bool poll(uint8_t *state);
+
+  /// Decode edge timestamps into a 39-byte state; checksums are not checked.
+  static bool decode(const volatile uint32_t *edges, uint16_t count, uint8_t *state);
+
+  uint32_t get_frames_decoded() const { return this->frames_decoded_; }
+  uint32_t get_frames_invalid() const { return this->frames_invalid_; }
+
+ protected:
+  InternalGPIOPin *pin_{nullptr};
+  // Allocated in setup(), so units without a receiver pin do not carry the edge buffer
+  Daikin312ReceiverStore *store_{nullptr};
+  uint32_t frames_decoded_{0};
+  uint32_t frames_invalid_{0};
+};
+
+}  // namespace daikin_312
+}  // namespace esphome
@@ -0,0 +1,75 @@
+#include "daikin_312_schedule.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace daikin_312 {
+
+static const char *const TAG = "daikin_312.schedule";
+
+void Daikin312Schedule::load(uint32_t hash) {
+  // Editing the configured entries starts over from them instead of a table
+  // saved for the old ones
+  uint32_t defaults = 2166136261UL;
+  const auto *bytes = reinterpret_cast<const uint8_t *>(&this->table_);
+  for (size_t i = 0; i < 1 + this->table_.count * sizeof(Daikin312ScheduleEntry); i++) {
+    defaults ^= bytes[i];
+    defaults *= 16777619UL;
+  }
+  this->pref_ = global_preferences->make_preference<Daikin312ScheduleTable>(hash ^ defaults);
+
+  Daikin312ScheduleTable saved;
+  if (this->pref_.load(&saved) && saved.count <= DAIKIN312_SCHEDULE_MAX_ENTRIES) {
+    this->table_ = saved;
+    ESP_LOGD(TAG, "Restored %u entries", saved.count);
+  }
+}
+
+void Daikin312Schedule::save() { this->pref_.save(&this->table_); }
+
+uint8_t Daikin312Schedule::upper_bound_(uint16_t minute) const {
+  uint8_t low = 0;
+  uint8_t high = this->table_.count;
+  while (low < high) {
+    uint8_t mid = (low + high) / 2;
+    if (this->table_.entries[mid].minute <= minute) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+bool Daikin312Schedule::add(const Daikin312ScheduleEntry &entry) {
+  uint8_t index = this->upper_bound_(entry.minute);
+  if (index > 0 && this->table_.entries[index - 1].minute == entry.minute) {
+    this->table_.entries[index - 1] = entry;
+    return true;
+  }
+  if (this->table_.count >= DAIKIN312_SCHEDULE_MAX_ENTRIES) {
+    ESP_LOGW(TAG, "Schedule full, entry at minute %u dropped", entry.minute);
+    return false;
+  }
+
+  for (uint8_t i = this->table_.count; i > index; i--)
+    this->table_.entries[i] = this->table_.entries[i - 1];
+  this->table_.entries[index] = entry;
+  this->table_.count++;
+  return true;
+}
+
+const Daikin312ScheduleEntry *Daikin312Schedule::find_active(uint16_t minute) const {
+  if (this->empty())
+    return nullptr;
+  uint8_t index = this->upper_bound_(minute);
+  // Before the first entry of the week the last one is still in effect
+  return &this->table_.entries[index > 0 ? index - 1 : this->table_.count - 1];
+}
+
+uint16_t Daikin312Schedule::next_transition(uint16_t minute) const {
+  uint8_t index = this->upper_bound_(minute);
+  return this->table_.entries[index < this->table_.count ? index : 0].minute;
+}
+
+}  // namespace daikin_312
+}  // namespace esphome
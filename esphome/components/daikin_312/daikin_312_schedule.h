@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esphome/core/preferences.h"
+#include "esphome/core/time.h"
+
+namespace esphome {
+namespace daikin_312 {
+
+static const uint8_t DAIKIN312_SCHEDULE_MAX_ENTRIES = 32;
+static const uint16_t DAIKIN312_MINUTES_PER_WEEK = 7 * 24 * 60;
+
+/// One scheduled change. Fields set to DAIKIN312_SETTING_UNSET are left as they are.
+struct Daikin312ScheduleEntry {
+  uint16_t minute;  // minute of the week, 0 is Sunday 00:00
+  uint8_t mode;     // climate::ClimateMode
+  uint8_t target_temperature;
+  uint8_t fan_mode;  // climate::ClimateFanMode
+} __attribute__((packed));
+
+/// Entries sorted by minute, as stored in preferences.
+struct Daikin312ScheduleTable {
+  uint8_t count;
+  Daikin312ScheduleEntry entries[DAIKIN312_SCHEDULE_MAX_ENTRIES];
+} __attribute__((packed));
+
+/// A weekly schedule of fixed-size entries kept sorted by time of week, so
+/// the active entry and the next transition are found by binary search.
+class Daikin312Schedule {
+ public:
+  /// Load a previously saved table. Entries added before this call are the
+  /// defaults; a saved table replaces them unless the defaults have changed.
+  void load(uint32_t hash);
+  void save();
+
+  /// Insert an entry, replacing one at the same minute. False when full.
+  bool add(const Daikin312ScheduleEntry &entry);
+  void clear() { this->table_.count = 0; }
+  uint8_t size() const { return this->table_.count; }
+  bool empty() const { return this->table_.count == 0; }
+
+  /// The entry in effect at `minute`, wrapping around to the last one of the
+  /// week. nullptr when the schedule is empty.
+  const Daikin312ScheduleEntry *find_active(uint16_t minute) const;
+  /// Minute of the first entry after `minute`, wrapping around the week.
+  uint16_t next_transition(uint16_t minute) const;
+
+  static uint16_t minute_of_week(const ESPTime &time) {
+    return (time.day_of_week - 1) * 24 * 60 + time.hour * 60 + time.minute;
+  }
+
+ protected:
+  /// Index of the first entry after `minute`.
+  uint8_t upper_bound_(uint16_t minute) const;
+
+  Daikin312ScheduleTable table_{};
+  ESPPreferenceObject pref_;
+};
+
+}  // namespace daikin_312
+}  // namespace esphome
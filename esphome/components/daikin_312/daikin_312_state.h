@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cstdint>
+
+#include "daikin_312_protocol.h"
+
+namespace esphome {
+namespace daikin_312 {
+
+/// Location of a setting inside the 39-byte state.
+struct Daikin312Field {
+  uint8_t byte;
+  uint8_t shift;
+  uint8_t mask;  // unshifted
+};
+
+// State layout of the ARC466A58 remote (shared with the Daikin2 family)
+static constexpr Daikin312Field DAIKIN312_POWER2 = {6, 7, 0x01};  // inverted copy of POWER
+static constexpr Daikin312Field DAIKIN312_LIGHT = {7, 4, 0x03};
+static constexpr Daikin312Field DAIKIN312_BEEP = {7, 6, 0x03};
+static constexpr Daikin312Field DAIKIN312_EYE_AUTO = {13, 7, 0x01};
+static constexpr Daikin312Field DAIKIN312_SWING_H = {17, 0, 0xFF};
+static constexpr Daikin312Field DAIKIN312_SWING_V = {18, 0, 0x0F};
+static constexpr Daikin312Field DAIKIN312_POWER = {25, 0, 0x01};
+static constexpr Daikin312Field DAIKIN312_MODE = {25, 4, 0x07};
+static constexpr Daikin312Field DAIKIN312_TEMP = {26, 1, 0x3F};
+static constexpr Daikin312Field DAIKIN312_FAN = {28, 4, 0x0F};
+static constexpr Daikin312Field DAIKIN312_POWERFUL = {33, 0, 0x01};
+static constexpr Daikin312Field DAIKIN312_QUIET = {33, 5, 0x01};
+static constexpr Daikin312Field DAIKIN312_EYE = {36, 1, 0x01};
+static constexpr Daikin312Field DAIKIN312_ECONO = {36, 2, 0x01};
+static constexpr Daikin312Field DAIKIN312_PURIFY = {36, 4, 0x01};
+
+// Each section ends with the sum of its preceding bytes
+static constexpr uint8_t DAIKIN312_CHECKSUM1 = DAIKIN312_SECTION1_LENGTH - 1;
+static constexpr uint8_t DAIKIN312_CHECKSUM2 = DAIKIN312_STATE_LENGTH - 1;
+
+// Power-on state of the remote: powered off, auto mode, timers disabled
+static constexpr uint8_t DAIKIN312_DEFAULT_STATE[DAIKIN312_STATE_LENGTH] = {
+    0x11, 0xDA, 0x27, 0x00, 0x01, 0x00, 0xC0, 0x70, 0x08, 0x0C, 0x80, 0x04, 0xB0, 0x16, 0x24, 0x00, 0x00, 0xBE, 0xD0, 0x00,
+    0x11, 0xDA, 0x27, 0x00, 0x00, 0x08, 0x00, 0x00, 0xA0, 0x00, 0x00, 0x06, 0x60, 0x00, 0x00, 0xC1, 0x80, 0x60, 0x00,
+};
+
+/// The IR state of a Daikin312 unit. Setters are plain masked byte writes into
+/// the raw state; checksums are filled in when the state is read for sending.
+class Daikin312State {
+ public:
+  constexpr Daikin312State() : raw_{} {
+    for (uint8_t i = 0; i < DAIKIN312_STATE_LENGTH; i++)
+      this->raw_[i] = DAIKIN312_DEFAULT_STATE[i];
+    this->update_checksums_();
+  }
+
+  /// Replace the state, e.g. with a frame received from the remote.
+  constexpr void set_raw(const uint8_t *raw) {
+    for (uint8_t i = 0; i < DAIKIN312_STATE_LENGTH; i++)
+      this->raw_[i] = raw[i];
+  }
+
+  /// True if both sections carry the Daikin signature and a valid checksum.
+  static constexpr bool is_valid(const uint8_t *raw) {
+    for (uint8_t i = 0; i < 3; i++) {
+      if (raw[i] != DAIKIN312_DEFAULT_STATE[i] ||
+          raw[DAIKIN312_SECTION1_LENGTH + i] != DAIKIN312_DEFAULT_STATE[DAIKIN312_SECTION1_LENGTH + i])
+        return false;
+    }
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < DAIKIN312_CHECKSUM1; i++)
+      sum += raw[i];
+    if (raw[DAIKIN312_CHECKSUM1] != sum)
+      return false;
+    sum = 0;
+    for (uint8_t i = DAIKIN312_SECTION1_LENGTH; i < DAIKIN312_CHECKSUM2; i++)
+      sum += raw[i];
+    return raw[DAIKIN312_CHECKSUM2] == sum;
+  }
+
+  /// The complete state with valid checksums.
+  constexpr const uint8_t *get_raw() {
+    this->update_checksums_();
+    return this->raw_;
+  }
+
+  constexpr void set_power(bool on) {
+    this->set_(DAIKIN312_POWER, on);
+    this->set_(DAIKIN312_POWER2, !on);
+  }
+  constexpr bool get_power() const { return this->get_(DAIKIN312_POWER); }
+
+  constexpr void set_mode(uint8_t mode) {
+    switch (mode) {
+      case DAIKIN312_MODE_COOL:
+      case DAIKIN312_MODE_HEAT:
+      case DAIKIN312_MODE_FAN:
+      case DAIKIN312_MODE_DRY:
+        this->set_(DAIKIN312_MODE, mode);
+        break;
+      default:
+        this->set_(DAIKIN312_MODE, DAIKIN312_MODE_AUTO);
+        break;
+    }
+    // Cooling has a higher minimum setpoint
+    this->set_temp(this->get_temp());
+  }
+  constexpr uint8_t get_mode() const { return this->get_(DAIKIN312_MODE); }
+
+  constexpr void set_temp(uint8_t degrees) {
+    uint8_t min_temp = this->get_mode() == DAIKIN312_MODE_COOL ? DAIKIN312_COOL_MIN_TEMP : DAIKIN312_MIN_TEMP;
+    if (degrees < min_temp)
+      degrees = min_temp;
+    if (degrees > DAIKIN312_MAX_TEMP)
+      degrees = DAIKIN312_MAX_TEMP;
+    this->set_(DAIKIN312_TEMP, degrees);
+  }
+  constexpr uint8_t get_temp() const { return this->get_(DAIKIN312_TEMP); }
+
+  /// Fixed speeds are stored offset by two; out of range speeds select auto.
+  constexpr void set_fan(uint8_t speed) {
+    if (speed == DAIKIN312_FAN_AUTO || speed == DAIKIN312_FAN_QUIET) {
+      this->set_(DAIKIN312_FAN, speed);
+    } else if (speed < DAIKIN312_FAN_MIN || speed > DAIKIN312_FAN_MAX) {
+      this->set_(DAIKIN312_FAN, DAIKIN312_FAN_AUTO);
+    } else {
+      this->set_(DAIKIN312_FAN, speed + 2);
+    }
+  }
+  constexpr uint8_t get_fan() const {
+    uint8_t speed = this->get_(DAIKIN312_FAN);
+    return (speed == DAIKIN312_FAN_AUTO || speed == DAIKIN312_FAN_QUIET) ? speed : speed - 2;
+  }
+
+  constexpr void set_swing_vertical(uint8_t position) { this->set_(DAIKIN312_SWING_V, position); }
+  constexpr uint8_t get_swing_vertical() const { return this->get_(DAIKIN312_SWING_V); }
+  constexpr void set_swing_horizontal(uint8_t position) { this->set_(DAIKIN312_SWING_H, position); }
+  constexpr uint8_t get_swing_horizontal() const { return this->get_(DAIKIN312_SWING_H); }
+
+  // Powerful excludes both quiet and econo
+  constexpr void set_powerful(bool on) {
+    this->set_(DAIKIN312_POWERFUL, on);
+    if (on) {
+      this->set_(DAIKIN312_QUIET, false);
+      this->set_(DAIKIN312_ECONO, false);
+    }
+  }
+  constexpr bool get_powerful() const { return this->get_(DAIKIN312_POWERFUL); }
+  constexpr void set_quiet(bool on) {
+    this->set_(DAIKIN312_QUIET, on);
+    if (on)
+      this->set_(DAIKIN312_POWERFUL, false);
+  }
+  constexpr bool get_quiet() const { return this->get_(DAIKIN312_QUIET); }
+  constexpr void set_econo(bool on) {
+    this->set_(DAIKIN312_ECONO, on);
+    if (on)
+      this->set_(DAIKIN312_POWERFUL, false);
+  }
+  constexpr bool get_econo() const { return this->get_(DAIKIN312_ECONO); }
+
+  constexpr void set_eye(bool on) { this->set_(DAIKIN312_EYE, on); }
+  constexpr bool get_eye() const { return this->get_(DAIKIN312_EYE); }
+  constexpr void set_eye_auto(bool on) { this->set_(DAIKIN312_EYE_AUTO, on); }
+  constexpr bool get_eye_auto() const { return this->get_(DAIKIN312_EYE_AUTO); }
+  constexpr void set_purify(bool on) { this->set_(DAIKIN312_PURIFY, on); }
+  constexpr bool get_purify() const { return this->get_(DAIKIN312_PURIFY); }
+  constexpr void set_light(uint8_t light) { this->set_(DAIKIN312_LIGHT, light); }
+  constexpr uint8_t get_light() const { return this->get_(DAIKIN312_LIGHT); }
+  constexpr void set_beep(uint8_t beep) { this->set_(DAIKIN312_BEEP, beep); }
+  constexpr uint8_t get_beep() const { return this->get_(DAIKIN312_BEEP); }
+
+ protected:
+  constexpr void set_(const Daikin312Field &field, uint8_t value) {
+    uint8_t &byte = this->raw_[field.byte];
+    byte = (byte & ~(field.mask << field.shift)) | ((value & field.mask) << field.shift);
+  }
+  constexpr uint8_t get_(const Daikin312Field &field) const { return (this->raw_[field.byte] >> field.shift) & field.mask; }
+
+  constexpr void update_checksums_() {
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < DAIKIN312_CHECKSUM1; i++)
+      sum += this->raw_[i];
+    this->raw_[DAIKIN312_CHECKSUM1] = sum;
+    sum = 0;
+    for (uint8_t i = DAIKIN312_SECTION1_LENGTH; i < DAIKIN312_CHECKSUM2; i++)
+      sum += this->raw_[i];
+    this->raw_[DAIKIN312_CHECKSUM2] = sum;
+  }
+
+  uint8_t raw_[DAIKIN312_STATE_LENGTH];
+};
+
+}  // namespace daikin_312
+}  // namespace esphome
@@ -0,0 +1,211 @@
+#include "daikin_312_transmitter.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+#ifdef USE_ESP32
+#include <soc/soc_caps.h>
+#endif
+
+namespace esphome {
+namespace daikin_312 {
+
+static const char *const TAG = "daikin_312.transmitter";
+
+void Daikin312SoftTransmitter::setup(InternalGPIOPin *pin) {
+  this->pin_ = pin;
+  this->pin_->setup();
+  this->pin_->digital_write(false);
+
+  // 50% duty cycle carrier
+  uint32_t period = (1000000UL + DAIKIN312_CARRIER_FREQUENCY / 2) / DAIKIN312_CARRIER_FREQUENCY;
+  this->on_time_ = period / 2;
+  this->off_time_ = period - this->on_time_;
+}
+
+void Daikin312SoftTransmitter::send(const uint8_t *state) {
+  this->frames_sent_++;
+#ifdef USE_HOST
+  // No IR hardware on the host; record the frame so runs can be compared
+  memcpy(this->last_frame_, state, DAIKIN312_STATE_LENGTH);
+  ESP_LOGD(TAG, "Frame %" PRIu32 ": %s", this->frames_sent_, format_hex_pretty(state, DAIKIN312_STATE_LENGTH).c_str());
+  return;
+#endif
+  ESP_LOGV(TAG, "Sending frame with software carrier");
+  this->mark_(DAIKIN312_LEADER_MARK);
+  this->space_(DAIKIN312_LEADER_SPACE);
+
+  this->mark_(DAIKIN312_HEADER_MARK);
+  this->space_(DAIKIN312_HEADER_SPACE);
+  for (uint16_t i = 0; i < DAIKIN312_SECTION1_LENGTH; i++)
+    this->send_byte_(state[i]);
+  this->mark_(DAIKIN312_BIT_MARK);
+  this->space_(DAIKIN312_GAP);
+
+  this->mark_(DAIKIN312_HEADER_MARK);
+  this->space_(DAIKIN312_HEADER_SPACE);
+  for (uint16_t i = DAIKIN312_SECTION1_LENGTH; i < DAIKIN312_STATE_LENGTH; i++)
+    this->send_byte_(state[i]);
+  this->mark_(DAIKIN312_BIT_MARK);
+  this->space_(DAIKIN312_GAP);
+}
+
+void Daikin312SoftTransmitter::mark_(uint32_t usec) {
+  const uint32_t start = micros();
+  uint32_t elapsed = 0;
+  while (elapsed < usec) {
+    this->pin_->digital_write(true);
+    delay_microseconds_safe(std::min(this->on_time_, usec - elapsed));
+    this->pin_->digital_write(false);
+    elapsed = micros() - start;
+    if (elapsed >= usec)
+      break;
+    delay_microseconds_safe(std::min(this->off_time_, usec - elapsed));
+    elapsed = micros() - start;
+  }
+}
+
+void Daikin312SoftTransmitter::space_(uint32_t usec) {
+  this->pin_->digital_write(false);
+  delay_microseconds_safe(usec);
+}
+
+void Daikin312SoftTransmitter::send_byte_(uint8_t data) {
+  for (uint8_t bit = 0; bit < 8; bit++, data >>= 1) {
+    this->mark_(DAIKIN312_BIT_MARK);
+    this->space_((data & 1) ? DAIKIN312_ONE_SPACE : DAIKIN312_ZERO_SPACE);
+  }
+}
+
+#ifdef USE_ESP32
+
+static const uint32_t RMT_RESOLUTION_HZ = 1000000;  // 1 tick = 1 us
+static const uint32_t RMT_MAX_DURATION = 0x7FFF;     // 15-bit duration field
+
+bool Daikin312Transmitter::setup(InternalGPIOPin *pin) {
+  rmt_tx_channel_config_t channel_config{};
+  channel_config.gpio_num = static_cast<gpio_num_t>(pin->get_pin());
+  channel_config.clk_src = RMT_CLK_SRC_DEFAULT;
+  channel_config.resolution_hz = RMT_RESOLUTION_HZ;
+  channel_config.mem_block_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL;
+  channel_config.trans_queue_depth = 1;
+
+  esp_err_t err = rmt_new_tx_channel(&channel_config, &this->channel_);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to create RMT channel: %s", esp_err_to_name(err));
+    return false;
+  }
+
+  rmt_carrier_config_t carrier_config{};
+  carrier_config.frequency_hz = DAIKIN312_CARRIER_FREQUENCY;
+  carrier_config.duty_cycle = 0.5f;
+  err = rmt_apply_carrier(this->channel_, &carrier_config);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to apply RMT carrier: %s", esp_err_to_name(err));
+    rmt_del_channel(this->channel_);
+    this->channel_ = nullptr;
+    return false;
+  }
+
+  rmt_copy_encoder_config_t encoder_config{};
+  err = rmt_new_copy_encoder(&encoder_config, &this->encoder_);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to create RMT encoder: %s", esp_err_to_name(err));
+    rmt_del_channel(this->channel_);
+    this->channel_ = nullptr;
+    return false;
+  }
+
+  rmt_tx_event_callbacks_t callbacks{};
+  callbacks.on_trans_done = Daikin312Transmitter::on_trans_done_;
+  rmt_tx_register_event_callbacks(this->channel_, &callbacks, this);
+
+  err = rmt_enable(this->channel_);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to enable RMT channel: %s", esp_err_to_name(err));
+    rmt_del_encoder(this->encoder_);
+    rmt_del_channel(this->channel_);
+    this->encoder_ = nullptr;
+    this->channel_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void Daikin312Transmitter::encode(const uint8_t *state, Daikin312Frame *frame) {
+  frame->symbol_count = 0;
+  frame->airtime_us = 0;
+
+  add_pair_(frame, DAIKIN312_LEADER_MARK, DAIKIN312_LEADER_SPACE);
+
+  add_pair_(frame, DAIKIN312_HEADER_MARK, DAIKIN312_HEADER_SPACE);
+  for (uint16_t i = 0; i < DAIKIN312_SECTION1_LENGTH; i++)
+    add_byte_(frame, state[i]);
+  add_pair_(frame, DAIKIN312_BIT_MARK, DAIKIN312_GAP);
+
+  add_pair_(frame, DAIKIN312_HEADER_MARK, DAIKIN312_HEADER_SPACE);
+  for (uint16_t i = DAIKIN312_SECTION1_LENGTH; i < DAIKIN312_STATE_LENGTH; i++)
+    add_byte_(frame, state[i]);
+  add_pair_(frame, DAIKIN312_BIT_MARK, DAIKIN312_GAP);
+}
+
+uint32_t Daikin312Transmitter::transmit(const Daikin312Frame *frame) {
+  if (this->channel_ == nullptr || this->busy_.load())
+    return 0;
+
+  rmt_transmit_config_t transmit_config{};
+  transmit_config.loop_count = 0;
+
+  this->busy_.store(true);
+  esp_err_t err = rmt_transmit(this->channel_, this->encoder_, frame->symbols,
+                               frame->symbol_count * sizeof(rmt_symbol_word_t), &transmit_config);
+  if (err != ESP_OK) {
+    this->busy_.store(false);
+    ESP_LOGW(TAG, "RMT transmit failed: %s", esp_err_to_name(err));
+    return 0;
+  }
+
+  ESP_LOGV(TAG, "Sending %u RMT symbols (%" PRIu32 " us)", frame->symbol_count, frame->airtime_us);
+  return (frame->airtime_us + 999) / 1000;
+}
+
+bool IRAM_ATTR Daikin312Transmitter::on_trans_done_(rmt_channel_handle_t /*channel*/,
+                                                    const rmt_tx_done_event_data_t * /*event*/, void *arg) {
+  auto *transmitter = static_cast<Daikin312Transmitter *>(arg);
+  transmitter->busy_.store(false);
+  return false;
+}
+
+void Daikin312Transmitter::add_pair_(Daikin312Frame *frame, uint32_t mark, uint32_t space) {
+  frame->airtime_us += mark + space;
+
+  uint32_t first_space = space > RMT_MAX_DURATION ? RMT_MAX_DURATION : space;
+  rmt_symbol_word_t &symbol = frame->symbols[frame->symbol_count++];
+  symbol.level0 = 1;
+  symbol.duration0 = mark;
+  symbol.level1 = 0;
+  symbol.duration1 = first_space;
+
+  // Carry the remainder of an over-long space in an all-low symbol
+  uint32_t remaining = space - first_space;
+  if (remaining > 0) {
+    rmt_symbol_word_t &rest = frame->symbols[frame->symbol_count++];
+    uint32_t half = remaining / 2;
+    rest.level0 = 0;
+    rest.duration0 = remaining - half;
+    rest.level1 = 0;
+    rest.duration1 = half;
+  }
+}
+
+void Daikin312Transmitter::add_byte_(Daikin312Frame *frame, uint8_t data) {
+  for (uint8_t bit = 0; bit < 8; bit++, data >>= 1)
+    add_pair_(frame, DAIKIN312_BIT_MARK, (data & 1) ? DAIKIN312_ONE_SPACE : DAIKIN312_ZERO_SPACE);
+}
+#endif  // USE_ESP32
+
+}  // namespace daikin_312
+}  // namespace esphome
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "esphome/core/hal.h"
+#include "daikin_312_protocol.h"
+
+#ifdef USE_ESP32
+#include <atomic>
+#include <driver/rmt_tx.h>
+#endif
+
+namespace esphome {
+namespace daikin_312 {
+
+/// Sends Daikin312 frames by toggling the pin with a software generated
+/// carrier. Blocks the main loop for the whole frame, so it is only used where
+/// no RMT peripheral is available.
+class Daikin312SoftTransmitter {
+ public:
+  void setup(InternalGPIOPin *pin);
+  void send(const uint8_t *state);
+
+  uint32_t get_frames_sent() const { return this->frames_sent_; }
+#ifdef USE_HOST
+  /// Last frame handed to send(); on the host frames are recorded instead of sent.
+  const uint8_t *get_last_frame() const { return this->last_frame_; }
+#endif
+
+ protected:
+  void mark_(uint32_t usec);
+  void space_(uint32_t usec);
+  void send_byte_(uint8_t data);
+
+  InternalGPIOPin *pin_{nullptr};
+  uint32_t on_time_{0};
+  uint32_t off_time_{0};
+  uint32_t frames_sent_{0};
+#ifdef USE_HOST
+  uint8_t last_frame_[DAIKIN312_STATE_LENGTH]{};
+#endif
+};
+
+#ifdef USE_ESP32
+
+// Long gaps exceed the 15-bit RMT duration field and take an extra symbol each.
+static constexpr uint16_t DAIKIN312_RMT_SYMBOLS = DAIKIN312_FRAME_PAIRS + 2;
+
+/// A Daikin312 frame encoded into RMT symbols, ready to be clocked out.
+struct Daikin312Frame {
+  uint16_t symbol_count{0};
+  uint32_t airtime_us{0};
+  rmt_symbol_word_t symbols[DAIKIN312_RMT_SYMBOLS];
+};
+
+/// Sends Daikin312 frames through the ESP32 RMT peripheral. The frame is encoded
+/// into an RMT symbol buffer and clocked out by hardware, so transmit() returns
+/// immediately instead of blocking the main loop for the whole frame.
+class Daikin312Transmitter {
+ public:
+  bool setup(InternalGPIOPin *pin);
+
+  /// Encode the 39-byte state into mark/space symbols.
+  static void encode(const uint8_t *state, Daikin312Frame *frame);
+
+  /// Start sending an encoded frame. The frame is read by the driver while on
+  /// air and must stay untouched until is_busy() returns false. Returns the
+  /// airtime in milliseconds, or 0 if the transmission could not be started.
+  uint32_t transmit(const Daikin312Frame *frame);
+
+  /// True while a frame is still being clocked out.
+  bool is_busy() const { return this->busy_.load(); }
+
+ protected:
+  static bool on_trans_done_(rmt_channel_handle_t channel, const rmt_tx_done_event_data_t *event, void *arg);
+
+  static void add_pair_(Daikin312Frame *frame, uint32_t mark, uint32_t space);
+  static void add_byte_(Daikin312Frame *frame, uint8_t data);
+
+  rmt_channel_handle_t channel_{nullptr};
+  rmt_encoder_handle_t encoder_{nullptr};
+  std::atomic<bool> busy_{false};
+};
+#endif  // USE_ESP32
+
+}  // namespace daikin_312
+}  // namespace esphome
@@ -10,88 +10,33 @@ void Daikin312Select::setup() {
   if (this->parent_ == nullptr)
     return;
 
-  // Setup preferences for state restoration
-  this->pref_ = global_preferences->make_preference<size_t>(this->get_preference_hash());
-  
-  size_t restored_index;
-  bool has_restored = this->pref_.load(&restored_index) && this->has_index(restored_index);
+  this->parent_->add_on_settings_callback([this]() { this->publish_state(this->read_from_parent_()); });
 
-  if (has_restored) {
-    // Use restored state from preferences
-    const char *restored_value = this->option_at(restored_index);
-    ESP_LOGD(TAG, "Restored state: %s", restored_value);
-    
-    // Apply the restored state to the parent
-    if (this->type_ == DAIKIN312_SELECT_BEEP) {
-      uint8_t beep_value;
-      if (strcmp(restored_value, "Loud") == 0) {
-        beep_value = 2;  // kDaikinBeepLoud
-      } else if (strcmp(restored_value, "Quiet") == 0) {
-        beep_value = 1;  // kDaikinBeepQuiet
-      } else {
-        beep_value = 3;  // kDaikinBeepOff
-      }
-      this->parent_->set_beep(beep_value);
-    } else {
-      uint8_t light_value;
-      if (strcmp(restored_value, "Bright") == 0) {
-        light_value = 1;  // kDaikinLightBright
-      } else if (strcmp(restored_value, "Dim") == 0) {
-        light_value = 2;  // kDaikinLightDim
-      } else {
-        light_value = 3;  // kDaikinLightOff
-      }
-      this->parent_->set_light(light_value);
+  // The value is persisted in the parent's settings and already applied by it
+  Daikin312Setting setting = this->type_ == DAIKIN312_SELECT_BEEP ? DAIKIN312_SETTING_BEEP : DAIKIN312_SETTING_LIGHT;
+  if (!this->parent_->has_saved_setting(setting)) {
+    // Saved by this select before its value moved into the parent's settings;
+    // applying it stores it there
+    auto legacy = global_preferences->make_preference<size_t>(this->get_preference_hash());
+    size_t index;
+    if (legacy.load(&index) && index < OPTION_COUNT) {
+      this->apply_option_(index);
+      ESP_LOGD(TAG, "Migrated state: %s", this->option_at(index));
+      this->publish_state(index);
+      return;
     }
-    this->publish_state(restored_index);
-  } else if (this->type_ == DAIKIN312_SELECT_LIGHT && this->has_initial_option_) {
-    uint8_t light_value;
-    const char *light_option;
-    if (this->initial_option_ == "Bright") {
-      light_value = 1;  // kDaikinLightBright
-      light_option = "Bright";
-    } else if (this->initial_option_ == "Dim") {
-      light_value = 2;  // kDaikinLightDim
-      light_option = "Dim";
-    } else {
-      light_value = 3;  // kDaikinLightOff
-      light_option = "Off";
-    }
-    this->parent_->set_light(light_value);
-    this->publish_state(light_option);
-  } else {
-    // No saved state, get current state from parent
-    uint8_t value;
-    if (this->type_ == DAIKIN312_SELECT_BEEP) {
-      value = this->parent_->get_beep();
-      switch (value) {
-        case 1:  // kDaikinBeepQuiet
-          this->publish_state("Quiet");
-          break;
-        case 2:  // kDaikinBeepLoud
-          this->publish_state("Loud");
-          break;
-        case 3:  // kDaikinBeepOff
-        default:
-          this->publish_state("Off");
-          break;
-      }
-    } else {
-      value = this->parent_->get_light();
-      switch (value) {
-        case 1:  // kDaikinLightBright
-          this->publish_state("Bright");
-          break;
-        case 2:  // kDaikinLightDim
-          this->publish_state("Dim");
-          break;
-        case 3:  // kDaikinLightOff
-        default:
-          this->publish_state("Off");
-          break;
-      }
+    if (this->type_ == DAIKIN312_SELECT_LIGHT && this->has_initial_option_) {
+      // Sent with the parent's boot restore frame
+      index = this->index_of(this->initial_option_).value_or(0);
+      this->apply_option_(index);
+      this->publish_state(index);
+      return;
     }
   }
+
+  size_t index = this->read_from_parent_();
+  ESP_LOGD(TAG, "Restored state: %s", this->option_at(index));
+  this->publish_state(index);
 }
 
 void Daikin312Select::dump_config() {
@@ -108,33 +53,32 @@ void Daikin312Select::control(const std::string &value) {
   if (this->parent_ == nullptr)
     return;
 
+  auto index = this->index_of(value);
+  if (!index.has_value()) {
+    ESP_LOGW(TAG, "Unknown option: %s", value.c_str());
+    return;
+  }
+
+  // Saved with the parent's settings
+  this->apply_option_(index.value());
+  this->publish_state(index.value());
+}
+
+const uint8_t *Daikin312Select::option_values_() const {
+  return this->type_ == DAIKIN312_SELECT_BEEP ? BEEP_OPTION_VALUES : LIGHT_OPTION_VALUES;
+}
+
+size_t Daikin312Select::read_from_parent_() {
+  uint8_t value = this->type_ == DAIKIN312_SELECT_BEEP ? this->parent_->get_beep() : this->parent_->get_light();
+  return option_index(this->option_values_(), value);
+}
+
+void Daikin312Select::apply_option_(size_t index) {
+  uint8_t value = this->option_values_()[index];
   if (this->type_ == DAIKIN312_SELECT_BEEP) {
-    uint8_t beep_value;
-    if (value == "Loud") {
-      beep_value = 2;  // kDaikinBeepLoud
-    } else if (value == "Quiet") {
-      beep_value = 1;  // kDaikinBeepQuiet
-    } else {
-      beep_value = 3;  // kDaikinBeepOff
-    }
-    this->parent_->set_beep(beep_value);
+    this->parent_->set_beep(value);
   } else {
-    uint8_t light_value;
-    if (value == "Bright") {
-      light_value = 1;  // kDaikinLightBright
-    } else if (value == "Dim") {
-      light_value = 2;  // kDaikinLightDim
-    } else {
-      light_value = 3;  // kDaikinLightOff
-    }
-    this->parent_->set_light(light_value);
-  }
-  this->publish_state(value);
-  
-  // Save state to preferences
-  auto index = this->index_of(value);
-  if (index.has_value()) {
-    this->pref_.save(&index.value());
+    this->parent_->set_light(value);
   }
 }
 
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "esphome/core/component.h"
-#include "esphome/core/preferences.h"
 #include "esphome/components/select/select.h"
 #include "../daikin_312.h"
 
@@ -28,11 +27,15 @@ class Daikin312Select : public select::Select, public Component {
  protected:
   void control(const std::string &value) override;
 
+  /// IR values of this select's options, in option order
+  const uint8_t *option_values_() const;
+  void apply_option_(size_t index);
+  size_t read_from_parent_();
+
   Daikin312Climate *parent_;
   Daikin312SelectType type_{DAIKIN312_SELECT_LIGHT};
   std::string initial_option_;
   bool has_initial_option_{false};
-  ESPPreferenceObject pref_;
 };
 
 }  // namespace daikin_312
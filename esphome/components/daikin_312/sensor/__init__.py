@@ -0,0 +1,82 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_TYPE,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_MILLISECOND,
+)
+from .. import CONF_DAIKIN_312_ID, Daikin312Climate, daikin_312_ns
+
+DEPENDENCIES = ["daikin_312"]
+CODEOWNERS = ["@carl09"]
+
+ICON_REMOTE = "mdi:remote"
+ICON_TIMER_SAND = "mdi:timer-sand"
+ICON_UPLOAD = "mdi:upload"
+UNIT_FRAMES = "frames"
+
+Daikin312TelemetryType = daikin_312_ns.enum("Daikin312TelemetryType")
+TELEMETRY_TYPES = {
+    "frames_sent": Daikin312TelemetryType.DAIKIN312_TELEMETRY_FRAMES_SENT,
+    "frames_coalesced": Daikin312TelemetryType.DAIKIN312_TELEMETRY_FRAMES_COALESCED,
+    "frames_suppressed": Daikin312TelemetryType.DAIKIN312_TELEMETRY_FRAMES_SUPPRESSED,
+    "blocked_time": Daikin312TelemetryType.DAIKIN312_TELEMETRY_BLOCKED_TIME,
+    "frames_climate": Daikin312TelemetryType.DAIKIN312_TELEMETRY_FRAMES_CLIMATE,
+    "frames_switch": Daikin312TelemetryType.DAIKIN312_TELEMETRY_FRAMES_SWITCH,
+    "frames_select": Daikin312TelemetryType.DAIKIN312_TELEMETRY_FRAMES_SELECT,
+    "frames_restore": Daikin312TelemetryType.DAIKIN312_TELEMETRY_FRAMES_RESTORE,
+    "frames_internal": Daikin312TelemetryType.DAIKIN312_TELEMETRY_FRAMES_INTERNAL,
+    "state_publishes": Daikin312TelemetryType.DAIKIN312_TELEMETRY_STATE_PUBLISHES,
+    "frames_verified": Daikin312TelemetryType.DAIKIN312_TELEMETRY_FRAMES_VERIFIED,
+    "frame_retries": Daikin312TelemetryType.DAIKIN312_TELEMETRY_FRAME_RETRIES,
+    "frames_unverified": Daikin312TelemetryType.DAIKIN312_TELEMETRY_FRAMES_UNVERIFIED,
+}
+
+
+FRAME_COUNT_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_FRAMES,
+    icon=ICON_REMOTE,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_TOTAL_INCREASING,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+BLOCKED_TIME_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_MILLISECOND,
+    icon=ICON_TIMER_SAND,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_TOTAL_INCREASING,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+STATE_PUBLISHES_SCHEMA = sensor.sensor_schema(
+    icon=ICON_UPLOAD,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_TOTAL_INCREASING,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+SCHEMAS = {
+    "blocked_time": BLOCKED_TIME_SCHEMA,
+    "state_publishes": STATE_PUBLISHES_SCHEMA,
+}
+
+CONFIG_SCHEMA = cv.typed_schema(
+    {
+        type_: SCHEMAS.get(type_, FRAME_COUNT_SCHEMA).extend(
+            {
+                cv.Required(CONF_DAIKIN_312_ID): cv.use_id(Daikin312Climate),
+            }
+        )
+        for type_ in TELEMETRY_TYPES
+    },
+    lower=True,
+)
+
+
+async def to_code(config):
+    var = await sensor.new_sensor(config)
+    parent = await cg.get_variable(config[CONF_DAIKIN_312_ID])
+    cg.add(parent.set_telemetry_sensor(TELEMETRY_TYPES[config[CONF_TYPE]], var))
@@ -1,7 +1,7 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import switch
-from esphome.const import CONF_TYPE, ICON_AIR_FILTER
+from esphome.const import CONF_RESTORE_MODE, CONF_TYPE, ICON_AIR_FILTER
 from .. import CONF_DAIKIN_312_ID, Daikin312Climate, daikin_312_ns
 
 DEPENDENCIES = ["daikin_312"]
@@ -48,3 +48,7 @@ async def to_code(config):
     parent = await cg.get_variable(config[CONF_DAIKIN_312_ID])
     cg.add(var.set_parent(parent))
     cg.add(var.set_switch_type(config[CONF_TYPE]))
+    # The state is saved with the parent's settings, so the base switch keeps
+    # no preference of its own and the switch applies the restore mode itself
+    cg.add(var.set_settings_restore_mode(config[CONF_RESTORE_MODE]))
+    cg.add(var.set_restore_mode(switch.RESTORE_MODES["DISABLED"]))
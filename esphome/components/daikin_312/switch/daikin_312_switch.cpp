@@ -6,66 +6,55 @@ namespace daikin_312 {
 
 static const char *const TAG = "daikin_312.switch";
 
+// Display names, indexed by Daikin312SwitchType
+static const char *const SWITCH_TYPE_NAMES[] = {"Purify", "Eye", "Eye Auto"};
+
+// Parent setting persisting each switch type, indexed by Daikin312SwitchType
+static const Daikin312Setting SWITCH_SETTINGS[] = {DAIKIN312_SETTING_PURIFY, DAIKIN312_SETTING_EYE,
+                                                   DAIKIN312_SETTING_EYE_AUTO};
+
 void Daikin312Switch::setup() {
   if (this->parent_ == nullptr)
     return;
 
-  // Try to restore state from preferences first
-  auto restored = this->get_initial_state_with_restore_mode();
+  // The state is persisted in the parent's settings, so the configured restore
+  // mode is interpreted here
+  switch_::SwitchRestoreMode mode = this->settings_restore_mode_;
+  bool persistent = mode & switch_::RESTORE_MODE_PERSISTENT_MASK;
+
   bool state;
-  
-  if (restored.has_value()) {
-    // Use restored state from preferences
-    state = restored.value();
-    ESP_LOGD(TAG, "Restored state: %s", ONOFF(state));
-    
-    // Apply the restored state to the parent (without sending IR yet, parent handles that)
-    switch (this->type_) {
-      case DAIKIN312_SWITCH_EYE:
-        this->parent_->set_eye(state);
-        break;
-      case DAIKIN312_SWITCH_EYE_AUTO:
-        this->parent_->set_eye_auto(state);
-        break;
-      case DAIKIN312_SWITCH_PURIFY:
-      default:
-        this->parent_->set_purify_enabled(state);
-        break;
+  optional<bool> legacy;
+  if (mode & switch_::RESTORE_MODE_DISABLED_MASK) {
+    state = this->read_from_parent_();
+  } else if (persistent && this->parent_->has_saved_setting(SWITCH_SETTINGS[this->type_])) {
+    // Already applied by the parent
+    state = this->read_from_parent_();
+    if (mode & switch_::RESTORE_MODE_INVERTED_MASK) {
+      state = !state;
+      this->apply_to_parent_(state);
     }
+    ESP_LOGD(TAG, "Restored state: %s", ONOFF(state));
+  } else if (persistent && (legacy = this->get_initial_state()).has_value()) {
+    // Saved by this switch before its state moved into the parent's settings;
+    // applying it stores it there
+    state = *legacy;
+    if (mode & switch_::RESTORE_MODE_INVERTED_MASK)
+      state = !state;
+    this->apply_to_parent_(state);
+    ESP_LOGD(TAG, "Migrated state: %s", ONOFF(state));
   } else {
-    // No restore mode or no saved state, get current state from parent
-    switch (this->type_) {
-      case DAIKIN312_SWITCH_EYE:
-        state = this->parent_->get_eye();
-        break;
-      case DAIKIN312_SWITCH_EYE_AUTO:
-        state = this->parent_->get_eye_auto();
-        break;
-      case DAIKIN312_SWITCH_PURIFY:
-      default:
-        state = this->parent_->get_purify();
-        break;
-    }
+    // Sent with the parent's boot restore frame
+    state = mode & switch_::RESTORE_MODE_ON_MASK;
+    this->apply_to_parent_(state);
   }
   this->publish_state(state);
+
+  this->parent_->add_on_settings_callback([this]() { this->publish_state(this->read_from_parent_()); });
 }
 
 void Daikin312Switch::dump_config() {
-  const char *type_name;
-  switch (this->type_) {
-    case DAIKIN312_SWITCH_EYE:
-      type_name = "Eye";
-      break;
-    case DAIKIN312_SWITCH_EYE_AUTO:
-      type_name = "Eye Auto";
-      break;
-    case DAIKIN312_SWITCH_PURIFY:
-    default:
-      type_name = "Purify";
-      break;
-  }
   LOG_SWITCH("", "Daikin 312", this);
-  ESP_LOGCONFIG(TAG, "  Type: %s", type_name);
+  ESP_LOGCONFIG(TAG, "  Type: %s", SWITCH_TYPE_NAMES[this->type_]);
   ESP_LOGCONFIG(TAG, "  Current state: %s", ONOFF(this->state));
 }
 
@@ -73,6 +62,11 @@ void Daikin312Switch::write_state(bool state) {
   if (this->parent_ == nullptr)
     return;
 
+  this->apply_to_parent_(state);
+  this->publish_state(state);
+}
+
+void Daikin312Switch::apply_to_parent_(bool state) {
   switch (this->type_) {
     case DAIKIN312_SWITCH_EYE:
       this->parent_->set_eye(state);
@@ -85,7 +79,18 @@ void Daikin312Switch::write_state(bool state) {
       this->parent_->set_purify_enabled(state);
       break;
   }
-  this->publish_state(state);
+}
+
+bool Daikin312Switch::read_from_parent_() {
+  switch (this->type_) {
+    case DAIKIN312_SWITCH_EYE:
+      return this->parent_->get_eye();
+    case DAIKIN312_SWITCH_EYE_AUTO:
+      return this->parent_->get_eye_auto();
+    case DAIKIN312_SWITCH_PURIFY:
+    default:
+      return this->parent_->get_purify();
+  }
 }
 
 }  // namespace daikin_312
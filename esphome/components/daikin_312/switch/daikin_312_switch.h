@@ -17,6 +17,9 @@ class Daikin312Switch : public switch_::Switch, public Component {
  public:
   void set_parent(Daikin312Climate *parent) { this->parent_ = parent; }
   void set_switch_type(Daikin312SwitchType type) { this->type_ = type; }
+  /// The configured restore mode; the base switch's own is disabled by codegen
+  /// because the state is persisted in the parent's settings.
+  void set_settings_restore_mode(switch_::SwitchRestoreMode mode) { this->settings_restore_mode_ = mode; }
 
   void setup() override;
   void dump_config() override;
@@ -24,8 +27,12 @@ class Daikin312Switch : public switch_::Switch, public Component {
  protected:
   void write_state(bool state) override;
 
+  void apply_to_parent_(bool state);
+  bool read_from_parent_();
+
   Daikin312Climate *parent_;
   Daikin312SwitchType type_{DAIKIN312_SWITCH_PURIFY};
+  switch_::SwitchRestoreMode settings_restore_mode_{switch_::SWITCH_RESTORE_DEFAULT_OFF};
 };
 
 }  // namespace daikin_312
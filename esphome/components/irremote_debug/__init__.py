@@ -1,21 +1,29 @@
 """IRremote Debug component for ESPHome."""
 
 import esphome.codegen as cg
-from esphome import pins
+from esphome import automation, pins
 import esphome.config_validation as cv
 from esphome.const import (
     CONF_ID,
+    CONF_INDEX,
     CONF_PIN,
     CONF_BUFFER_SIZE,
     CONF_TIMEOUT,
 )
 from esphome.core import CORE
 
+from .protocols import IR_PROTOCOLS
+
 CODEOWNERS = ["@carl09"]
 DEPENDENCIES = ["logger"]
 
 CONF_IRREMOTE_DEBUG_ID = "irremote_debug_id"
 CONF_VERBOSITY = "verbosity"
+CONF_DECODE_MODE = "decode_mode"
+CONF_HISTORY_SIZE = "history_size"
+CONF_DECODE_TASK_CORE = "decode_task_core"
+CONF_ALLOWED_PROTOCOLS = "allowed_protocols"
+CONF_PROTOCOLS = "protocols"
 
 irremote_debug_ns = cg.esphome_ns.namespace("irremote_debug")
 IRremoteDebugComponent = irremote_debug_ns.class_(
@@ -30,17 +38,65 @@ VERBOSITY_LEVELS = {
     "raw": VerbosityLevel.VERBOSITY_RAW,
 }
 
-CONFIG_SCHEMA = cv.Schema(
-    {
-        cv.GenerateID(): cv.declare_id(IRremoteDebugComponent),
-        cv.Required(CONF_PIN): pins.internal_gpio_input_pin_schema,
-        cv.Optional(CONF_BUFFER_SIZE, default=1024): cv.int_range(min=100, max=2048),
-        cv.Optional(CONF_TIMEOUT, default="15ms"): cv.positive_time_period_milliseconds,
-        cv.Optional(CONF_VERBOSITY, default="normal"): cv.enum(
-            VERBOSITY_LEVELS, lower=True
-        ),
-    }
-).extend(cv.polling_component_schema("100ms"))
+DumpSignalAction = irremote_debug_ns.class_("DumpSignalAction", automation.Action)
+
+DecodeMode = irremote_debug_ns.enum("DecodeMode")
+DECODE_MODES = {
+    "event": DecodeMode.DECODE_MODE_EVENT,
+    "poll": DecodeMode.DECODE_MODE_POLL,
+    "task": DecodeMode.DECODE_MODE_TASK,
+}
+
+
+validate_protocol = cv.one_of(*IR_PROTOCOLS, upper=True)
+
+
+def validate_decode_mode(config):
+    if config[CONF_DECODE_MODE] != "task":
+        return config
+    if not CORE.is_esp32:
+        raise cv.Invalid("decode_mode 'task' is only available on ESP32")
+    if config[CONF_HISTORY_SIZE] < 2:
+        raise cv.Invalid("decode_mode 'task' requires a history_size of at least 2")
+    return config
+
+
+def validate_protocols(config):
+    if CONF_PROTOCOLS not in config:
+        return config
+    compiled = {IR_PROTOCOLS[protocol] for protocol in config[CONF_PROTOCOLS]}
+    for protocol in config.get(CONF_ALLOWED_PROTOCOLS, []):
+        if IR_PROTOCOLS[protocol] not in compiled:
+            raise cv.Invalid(
+                f"Allowed protocol {protocol} is not in 'protocols' and would never be decoded"
+            )
+    return config
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(IRremoteDebugComponent),
+            cv.Required(CONF_PIN): pins.internal_gpio_input_pin_schema,
+            cv.Optional(CONF_BUFFER_SIZE, default=1024): cv.int_range(min=100, max=2048),
+            cv.Optional(CONF_TIMEOUT, default="15ms"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_VERBOSITY, default="normal"): cv.enum(
+                VERBOSITY_LEVELS, lower=True
+            ),
+            cv.Optional(CONF_DECODE_MODE, default="event"): cv.enum(
+                DECODE_MODES, lower=True
+            ),
+            cv.Optional(CONF_HISTORY_SIZE, default=4): cv.int_range(min=1, max=16),
+            cv.Optional(CONF_DECODE_TASK_CORE, default=0): cv.int_range(min=0, max=1),
+            # Protocol names as used by IRremoteESP8266, e.g. NEC, DAIKIN312
+            cv.Optional(CONF_ALLOWED_PROTOCOLS): cv.ensure_list(validate_protocol),
+            # Compile in only these protocols instead of all of them
+            cv.Optional(CONF_PROTOCOLS): cv.ensure_list(validate_protocol),
+        }
+    ).extend(cv.polling_component_schema("100ms")),
+    validate_decode_mode,
+    validate_protocols,
+)
 
 
 async def to_code(config):
@@ -58,11 +114,25 @@ async def to_code(config):
     cg.add(var.set_buffer_size(config[CONF_BUFFER_SIZE]))
     cg.add(var.set_timeout(config[CONF_TIMEOUT]))
     cg.add(var.set_verbosity(config[CONF_VERBOSITY]))
+    cg.add(var.set_decode_mode(config[CONF_DECODE_MODE]))
+    cg.add(var.set_history_size(config[CONF_HISTORY_SIZE]))
+    cg.add(var.set_decode_task_core(config[CONF_DECODE_TASK_CORE]))
+    # Names are checked against IR_PROTOCOLS, so they are all decode_type_t values
+    for protocol in config.get(CONF_ALLOWED_PROTOCOLS, []):
+        cg.add(var.add_allowed_protocol(cg.RawExpression(f"decode_type_t::{protocol}")))
 
-    # This debug component needs ALL protocols enabled to decode unknown/any IR signals.
-    # Explicitly set _IR_ENABLE_DEFAULT_=true to override any other component's
-    # restrictive settings (e.g., daikin_312 sets it to false for size optimization)
-    cg.add_build_flag("-D_IR_ENABLE_DEFAULT_=true")
+    if protocols := config.get(CONF_PROTOCOLS):
+        # Only the listed protocols; every protocol adds decoder code to the
+        # firmware and a decode attempt to every capture
+        cg.add_build_flag("-D_IR_ENABLE_DEFAULT_=false")
+        for flag in sorted({IR_PROTOCOLS[protocol] for protocol in protocols}):
+            cg.add_build_flag(f"-DDECODE_{flag}=true")
+            # Needed by IRac to describe AC states
+            cg.add_build_flag(f"-DSEND_{flag}=true")
+    else:
+        # Without a list the debugger decodes every protocol. daikin_312 builds
+        # its frames itself and no longer sets library flags, so none are overridden.
+        cg.add_build_flag("-D_IR_ENABLE_DEFAULT_=true")
 
     # Add the IRremoteESP8266 library from the fork
     cg.add_library(
@@ -70,3 +140,21 @@ async def to_code(config):
         None,
         "https://github.com/carl09/IRremoteESP8266.git#daikin_312",
     )
+
+
+@automation.register_action(
+    "irremote_debug.dump_signal",
+    DumpSignalAction,
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.use_id(IRremoteDebugComponent),
+            cv.Optional(CONF_INDEX, default=0): cv.templatable(cv.int_range(min=0, max=15)),
+        }
+    ),
+)
+async def dump_signal_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    index = await cg.templatable(config[CONF_INDEX], args, cg.uint8)
+    cg.add(var.set_index(index))
+    return var
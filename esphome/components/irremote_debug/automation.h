@@ -0,0 +1,18 @@
+#pragma once
+
+#include "esphome/core/automation.h"
+#include "esphome/core/helpers.h"
+#include "irremote_debug.h"
+
+namespace esphome {
+namespace irremote_debug {
+
+template<typename... Ts> class DumpSignalAction : public Action<Ts...>, public Parented<IRremoteDebugComponent> {
+ public:
+  TEMPLATABLE_VALUE(uint8_t, index)
+
+  void play(Ts... x) override { this->parent_->dump_signal(this->index_.value(x...)); }
+};
+
+}  // namespace irremote_debug
+}  // namespace esphome
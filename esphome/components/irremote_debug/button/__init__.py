@@ -5,6 +5,7 @@ from esphome.components import button
 import esphome.config_validation as cv
 from esphome.const import (
     CONF_ID,
+    CONF_INDEX,
     ENTITY_CATEGORY_DIAGNOSTIC,
     ICON_PULSE,
 )
@@ -20,6 +21,7 @@ CONFIG_SCHEMA = button.button_schema(
 ).extend(
     {
         cv.GenerateID(CONF_IRREMOTE_DEBUG_ID): cv.use_id(IRremoteDebugComponent),
+        cv.Optional(CONF_INDEX, default=0): cv.int_range(min=0, max=15),
     }
 )
 
@@ -27,3 +29,4 @@ CONFIG_SCHEMA = button.button_schema(
 async def to_code(config):
     var = await button.new_button(config)
     await cg.register_parented(var, config[CONF_IRREMOTE_DEBUG_ID])
+    cg.add(var.set_index(config[CONF_INDEX]))
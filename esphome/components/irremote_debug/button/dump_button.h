@@ -10,9 +10,12 @@ namespace irremote_debug {
 class DumpButton : public button::Button, public Parented<IRremoteDebugComponent> {
  public:
   DumpButton() = default;
+  void set_index(uint8_t index) { this->index_ = index; }
 
  protected:
-  void press_action() override { this->parent_->dump_last_signal(); }
+  void press_action() override { this->parent_->dump_signal(this->index_); }
+
+  uint8_t index_{0};
 };
 
 }  // namespace irremote_debug
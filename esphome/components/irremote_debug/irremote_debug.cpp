@@ -1,13 +1,31 @@
 #include "irremote_debug.h"
+#include "log_line_writer.h"
+
+#include <algorithm>
+#include <cinttypes>
 
 namespace esphome {
 namespace irremote_debug {
 
 static const char *const TAG = "irremote_debug";
 
+// Remotes send repeats and multi-frame sequences in quick succession
+static const uint32_t BURST_WINDOW_MS = 1000;
+
 void IRremoteDebugComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up IRremote Debug...");
 
+  // Signals keep their own raw timings; the receiver's buffer is reused on resume()
+  RAMAllocator<uint16_t> allocator;
+  this->capture_arena_ = allocator.allocate(this->history_size_ * this->buffer_size_);
+  if (this->capture_arena_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate %zu bytes for %u signals, reduce history_size or buffer_size",
+             this->history_size_ * this->buffer_size_ * sizeof(uint16_t), this->history_size_);
+    this->mark_failed();
+    return;
+  }
+  this->history_ = new CapturedSignal[this->history_size_];  // NOLINT(cppcoreguidelines-owning-memory)
+
   uint8_t pin_num = this->pin_->get_pin();
   this->ir_receiver_ = new IRrecv(pin_num, this->buffer_size_, this->timeout_ms_, true);
   this->ir_receiver_->setUnknownThreshold(12);
@@ -16,14 +34,37 @@ void IRremoteDebugComponent::setup() {
 
   ESP_LOGCONFIG(TAG, "  Pin: GPIO%u", pin_num);
   ESP_LOGCONFIG(TAG, "  Buffer Size: %u", this->buffer_size_);
-  ESP_LOGCONFIG(TAG, "  Timeout: %u ms", this->timeout_ms_);
+  ESP_LOGCONFIG(TAG, "  Timeout: %" PRIu32 " ms", this->timeout_ms_);
+
+  if (this->decode_mode_ == DECODE_MODE_EVENT) {
+    // The library has no completion callback, but checking for a finished
+    // capture is a single flag read, so it is done every loop iteration.
+    this->stop_poller();
+    this->last_check_us_ = micros();
+#ifdef USE_ESP32
+  } else if (this->decode_mode_ == DECODE_MODE_TASK) {
+    // loop() is woken by the task whenever it has queued a signal
+    this->stop_poller();
+    this->disable_loop();
+    this->queue_capacity_ = this->history_size_ - 1;
+    if (xTaskCreatePinnedToCore(decode_task_, "ir_decode", 4096, this, 1, &this->decode_task_handle_,
+                                this->decode_task_core_) != pdPASS) {
+      ESP_LOGE(TAG, "Could not start the decode task");
+      this->mark_failed();
+    }
+#endif
+  } else {
+    this->disable_loop();
+  }
 }
 
 void IRremoteDebugComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "IRremote Debug:");
   ESP_LOGCONFIG(TAG, "  Pin: GPIO%u", this->pin_->get_pin());
   ESP_LOGCONFIG(TAG, "  Buffer Size: %u", this->buffer_size_);
-  ESP_LOGCONFIG(TAG, "  Timeout: %u ms", this->timeout_ms_);
+  ESP_LOGCONFIG(TAG, "  Timeout: %" PRIu32 " ms", this->timeout_ms_);
+  ESP_LOGCONFIG(TAG, "  History: %u signals (%zu bytes of raw timings)", this->history_size_,
+                this->history_size_ * this->buffer_size_ * sizeof(uint16_t));
 
   const char *verbosity_str;
   switch (this->verbosity_) {
@@ -43,24 +84,176 @@ void IRremoteDebugComponent::dump_config() {
       verbosity_str = "unknown";
   }
   ESP_LOGCONFIG(TAG, "  Verbosity: %s", verbosity_str);
+  if (this->decode_mode_ == DECODE_MODE_TASK) {
+    ESP_LOGCONFIG(TAG, "  Decode mode: task (core %u)", this->decode_task_core_);
+  } else {
+    ESP_LOGCONFIG(TAG, "  Decode mode: %s", this->decode_mode_ == DECODE_MODE_EVENT ? "event" : "poll");
+  }
+  ESP_LOGCONFIG(TAG, "  Signals received: %" PRIu32 " (%" PRIu32 " overflows)", this->signals_received_,
+                this->overflows_);
+  if (!this->allowed_protocols_.empty()) {
+    ESP_LOGCONFIG(TAG, "  Allowed protocols: %zu (%" PRIu32 " signals filtered)", this->allowed_protocols_.size(),
+                  this->signals_filtered_);
+  }
+  // Updated by the decode task in task mode, so a line may be momentarily stale
+  for (uint8_t i = 0; i < this->protocol_stats_count_; i++) {
+    const ProtocolStats &stats = this->protocol_stats_[i];
+    ESP_LOGCONFIG(TAG, "  %s: %" PRIu32 " hits, avg decode %" PRIu32 " us", typeToString(stats.protocol).c_str(),
+                  stats.hits, stats.decode_us / stats.hits);
+  }
+  if (this->decode_mode_ == DECODE_MODE_EVENT && this->signals_received_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Loop interval at pickup: avg %" PRIu32 " us, max %" PRIu32 " us",
+                  static_cast<uint32_t>(this->pickup_interval_total_us_ / this->signals_received_),
+                  this->pickup_interval_max_us_);
+  }
 }
 
-void IRremoteDebugComponent::update() {
-  decode_results results;
+void IRremoteDebugComponent::loop() {
+#ifdef USE_ESP32
+  if (this->decode_mode_ == DECODE_MODE_TASK) {
+    uint8_t slot;
+    while (this->decoded_queue_.pop(&slot)) {
+      this->process_signal_(&this->history_[slot].results);
+      this->processed_head_ = (slot + 1) % this->history_size_;
+      if (this->processed_count_ < this->history_size_)
+        this->processed_count_++;
+    }
+    // A signal queued from now on wakes the loop again
+    this->disable_loop();
+    return;
+  }
+#endif
+
+  // The capture finished at some point since the previous check; the library
+  // does not timestamp it, so the interval only bounds how long it waited
+  uint32_t now = micros();
+  uint32_t interval = now - this->last_check_us_;
+  this->last_check_us_ = now;
+
+  if (this->receive_()) {
+    this->pickup_interval_total_us_ += interval;
+    if (interval > this->pickup_interval_max_us_)
+      this->pickup_interval_max_us_ = interval;
+    ESP_LOGV(TAG, "Signal picked up %" PRIu32 " us after the previous loop check", interval);
+
+    // Stay responsive for the rest of the burst so the capture buffer is
+    // freed as soon as each signal ends
+    this->high_freq_.start();
+    this->burst_end_ = millis() + BURST_WINDOW_MS;
+  } else if (this->burst_end_.has_value() && static_cast<int32_t>(millis() - *this->burst_end_) >= 0) {
+    this->high_freq_.stop();
+    this->burst_end_.reset();
+  }
+}
+
+void IRremoteDebugComponent::update() { this->receive_(); }
+
+bool IRremoteDebugComponent::receive_() {
+  CapturedSignal *signal = this->capture_();
+  if (signal == nullptr)
+    return false;
+  this->process_signal_(&signal->results);
+  return true;
+}
 
-  if (this->ir_receiver_->decode(&results)) {
-    // Store for later re-dump
-    this->last_results_ = results;
-    this->last_signal_valid_ = true;
+CapturedSignal *IRremoteDebugComponent::capture_() {
+  decode_results results;
 
-    // Process and log
-    this->process_signal_(&results);
+  uint32_t start = micros();
+  if (!this->ir_receiver_->decode(&results))
+    return nullptr;
+  this->record_protocol_(results.decode_type, micros() - start);
 
-    // Resume receiving
+  if (!this->is_allowed_(results.decode_type)) {
+    this->signals_filtered_++;
     this->ir_receiver_->resume();
+    return nullptr;
+  }
+
+  this->signals_received_++;
+  if (results.overflow)
+    this->overflows_++;
+
+  // Copy the signal out of the receiver's buffer, so receiving can resume
+  // before the (slow) logging
+  CapturedSignal *signal = this->store_signal_(results);
+  this->ir_receiver_->resume();
+  return signal;
+}
+
+bool IRremoteDebugComponent::is_allowed_(decode_type_t protocol) const {
+  if (this->allowed_protocols_.empty())
+    return true;
+  return std::find(this->allowed_protocols_.begin(), this->allowed_protocols_.end(), protocol) !=
+         this->allowed_protocols_.end();
+}
+
+void IRremoteDebugComponent::record_protocol_(decode_type_t protocol, uint32_t decode_us) {
+  uint8_t i = 0;
+  while (i < this->protocol_stats_count_ && this->protocol_stats_[i].protocol != protocol)
+    i++;
+  if (i == this->protocol_stats_count_) {
+    if (i == PROTOCOL_STATS_SIZE) {
+      // Full; the least frequent protocol makes room
+      i--;
+    } else {
+      this->protocol_stats_count_++;
+    }
+    this->protocol_stats_[i] = {protocol, 0, 0};
+  }
+  this->protocol_stats_[i].hits++;
+  this->protocol_stats_[i].decode_us += decode_us;
+
+  // Keep the most frequent protocols first
+  while (i > 0 && this->protocol_stats_[i].hits > this->protocol_stats_[i - 1].hits) {
+    std::swap(this->protocol_stats_[i], this->protocol_stats_[i - 1]);
+    i--;
   }
 }
 
+#ifdef USE_ESP32
+void IRremoteDebugComponent::decode_task_(void *arg) {
+  auto *component = static_cast<IRremoteDebugComponent *>(arg);
+  while (true) {
+    // While the queue is full the capture stays in the receiver, which holds
+    // off new ones until the main loop has caught up
+    if (component->decoded_queue_.size() < component->queue_capacity_) {
+      // Paired with dump_signal(): either it sees this capture running and
+      // waits, or this sees its hold and skips
+      component->capturing_.store(true);
+      CapturedSignal *signal = component->hold_captures_.load() ? nullptr : component->capture_();
+      component->capturing_.store(false);
+      if (signal != nullptr) {
+        component->decoded_queue_.push(signal - component->history_);
+        component->enable_loop_soon_any_context();
+        continue;
+      }
+    }
+    vTaskDelay(1);
+  }
+}
+#endif
+
+CapturedSignal *IRremoteDebugComponent::store_signal_(const decode_results &results) {
+  uint8_t slot = this->history_head_;
+  this->history_head_ = (slot + 1) % this->history_size_;
+  if (this->history_count_ < this->history_size_)
+    this->history_count_++;
+
+  CapturedSignal *signal = &this->history_[slot];
+  uint16_t *rawbuf = &this->capture_arena_[slot * this->buffer_size_];
+  uint16_t rawlen = std::min(results.rawlen, this->buffer_size_);
+  for (uint16_t i = 0; i < rawlen; i++)
+    rawbuf[i] = results.rawbuf[i];
+
+  signal->results = results;
+  signal->results.rawbuf = rawbuf;
+  signal->results.rawlen = rawlen;
+  signal->received_at = millis();
+  signal->sequence = this->signals_received_;
+  return signal;
+}
+
 void IRremoteDebugComponent::process_signal_(decode_results *results) {
   ESP_LOGI(TAG, "========== IR Signal Received ==========");
 
@@ -135,13 +328,12 @@ void IRremoteDebugComponent::log_detailed_(decode_results *results) {
 
     // Log raw state bytes
     ESP_LOGI(TAG, "State Length: %u bytes", results->bits / 8);
-    String state_str = "State: ";
-    for (uint16_t i = 0; i < (results->bits / 8); i++) {
-      char hex[4];
-      snprintf(hex, sizeof(hex), "%02X ", results->state[i]);
-      state_str += hex;
+    {
+      LogLineWriter line(TAG);
+      line.printf("State:");
+      for (uint16_t i = 0; i < (results->bits / 8); i++)
+        line.printf(" %02X", results->state[i]);
     }
-    ESP_LOGI(TAG, "%s", state_str.c_str());
 
     // Use IRac to get human-readable state if possible
     stdAc::state_t ac_state;
@@ -248,42 +440,22 @@ void IRremoteDebugComponent::log_raw_(decode_results *results) {
   ESP_LOGI(TAG, "--- Raw Timing Data ---");
   ESP_LOGI(TAG, "Raw Length: %u", results->rawlen);
 
-  // Output in format suitable for IRremoteESP8266 analysis tools
-  String raw_output = "uint16_t rawData[";
-  raw_output += String(results->rawlen - 1);
-  raw_output += "] = {";
-
-  for (uint16_t i = 1; i < results->rawlen; i++) {
-    if (i > 1) {
-      raw_output += ", ";
-    }
-    raw_output += String(results->rawbuf[i] * kRawTick);
-  }
-  raw_output += "};";
-
-  // Log raw data in chunks to avoid log buffer overflow
-  uint16_t chunk_size = 200;
-  for (uint16_t i = 0; i < raw_output.length(); i += chunk_size) {
-    String chunk = raw_output.substring(i, min((uint16_t)(i + chunk_size), (uint16_t)raw_output.length()));
-    ESP_LOGI(TAG, "%s", chunk.c_str());
-  }
+  // Output in format suitable for IRremoteESP8266 analysis tools, streamed
+  // line by line instead of building the whole array in memory
+  LogLineWriter line(TAG);
+  line.printf("uint16_t rawData[%u] = {", results->rawlen - 1);
+  for (uint16_t i = 1; i < results->rawlen; i++)
+    line.printf(i > 1 ? ", %u" : "%u", results->rawbuf[i] * kRawTick);
+  line.printf("};");
+  line.flush();
 
   // Output state array if it's an AC protocol
   if (hasACState(results->decode_type)) {
-    String state_output = "uint8_t state[";
-    state_output += String(results->bits / 8);
-    state_output += "] = {";
-
-    for (uint16_t i = 0; i < (results->bits / 8); i++) {
-      if (i > 0) {
-        state_output += ", ";
-      }
-      char hex[5];
-      snprintf(hex, sizeof(hex), "0x%02X", results->state[i]);
-      state_output += hex;
-    }
-    state_output += "};";
-    ESP_LOGI(TAG, "%s", state_output.c_str());
+    line.printf("uint8_t state[%u] = {", results->bits / 8);
+    for (uint16_t i = 0; i < (results->bits / 8); i++)
+      line.printf(i > 0 ? ", 0x%02X" : "0x%02X", results->state[i]);
+    line.printf("};");
+    line.flush();
   } else if (results->decode_type != decode_type_t::UNKNOWN) {
     ESP_LOGI(TAG, "uint64_t data = 0x%llX;", results->value);
   }
@@ -315,15 +487,40 @@ std::string IRremoteDebugComponent::get_protocol_string_(decode_results *results
   return result;
 }
 
-void IRremoteDebugComponent::dump_last_signal() {
-  if (!this->last_signal_valid_) {
+void IRremoteDebugComponent::dump_signal(uint8_t index) {
+#ifdef USE_ESP32
+  if (this->decode_mode_ == DECODE_MODE_TASK) {
+    // The task writes slots and the head concurrently; stop it (a signal
+    // arriving meanwhile waits in the receiver) and only read processed slots
+    this->hold_captures_.store(true);
+    while (this->capturing_.load())
+      vTaskDelay(1);
+    // Queued signals may already have overwritten the oldest processed ones
+    uint8_t count = std::min<uint8_t>(this->processed_count_, this->history_size_ - this->decoded_queue_.size());
+    this->dump_slot_(index, this->processed_head_, count);
+    this->hold_captures_.store(false);
+    return;
+  }
+#endif
+  this->dump_slot_(index, this->history_head_, this->history_count_);
+}
+
+void IRremoteDebugComponent::dump_slot_(uint8_t index, uint8_t head, uint8_t count) {
+  if (count == 0) {
     ESP_LOGW(TAG, "No IR signal has been received yet.");
     return;
   }
+  if (index >= count) {
+    ESP_LOGW(TAG, "Only %u signals are stored, cannot dump #%u", count, index);
+    return;
+  }
 
-  ESP_LOGI(TAG, "========== Dumping Last Signal ==========");
+  uint8_t slot = (head + this->history_size_ - 1 - index) % this->history_size_;
+  CapturedSignal *signal = &this->history_[slot];
+  ESP_LOGI(TAG, "========== Dumping Signal %u (#%" PRIu32 ", %" PRIu32 " s ago) ==========", index, signal->sequence,
+           (millis() - signal->received_at) / 1000);
   // Always dump at RAW level when manually triggered
-  this->log_raw_(&this->last_results_);
+  this->log_raw_(&signal->results);
   ESP_LOGI(TAG, "==========================================");
 }
 
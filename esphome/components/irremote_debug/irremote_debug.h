@@ -2,16 +2,26 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
 #ifdef USE_TEXT_SENSOR
 #include "esphome/components/text_sensor/text_sensor.h"
 #endif
 
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "spsc_queue.h"
+#include <atomic>
+#endif
+
 #include <IRrecv.h>
 #include <IRutils.h>
 #include <IRac.h>
 
+#include <vector>
+
 namespace esphome {
 namespace irremote_debug {
 
@@ -22,9 +32,31 @@ enum VerbosityLevel : uint8_t {
   VERBOSITY_RAW = 3,
 };
 
+enum DecodeMode : uint8_t {
+  DECODE_MODE_EVENT = 0,  // checked every loop iteration, high frequency during bursts
+  DECODE_MODE_POLL = 1,   // checked every update_interval
+  DECODE_MODE_TASK = 2,   // decoded on a separate FreeRTOS task (ESP32)
+};
+
+/// A received signal with its own copy of the raw timings.
+struct CapturedSignal {
+  decode_results results;  // rawbuf points into the component's capture arena
+  uint32_t received_at;    // millis()
+  uint32_t sequence;       // counts up from 1 for every signal received
+};
+
+/// Hits of one protocol; the table is kept ordered by hits, most frequent first.
+struct ProtocolStats {
+  decode_type_t protocol;
+  uint32_t hits;
+  uint32_t decode_us;  // total time spent in IRrecv::decode for these hits
+};
+static const uint8_t PROTOCOL_STATS_SIZE = 16;
+
 class IRremoteDebugComponent : public PollingComponent {
  public:
   void setup() override;
+  void loop() override;
   void update() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
@@ -33,18 +65,39 @@ class IRremoteDebugComponent : public PollingComponent {
   void set_buffer_size(uint16_t buffer_size) { this->buffer_size_ = buffer_size; }
   void set_timeout(uint32_t timeout) { this->timeout_ms_ = timeout; }
   void set_verbosity(VerbosityLevel verbosity) { this->verbosity_ = verbosity; }
+  void set_decode_mode(DecodeMode decode_mode) { this->decode_mode_ = decode_mode; }
+  void set_history_size(uint8_t history_size) { this->history_size_ = history_size; }
+  void set_decode_task_core(uint8_t core) { this->decode_task_core_ = core; }
+  /// Only log and store signals of these protocols; all protocols are shown
+  /// while the list is empty.
+  void add_allowed_protocol(decode_type_t protocol) { this->allowed_protocols_.push_back(protocol); }
+  void clear_allowed_protocols() { this->allowed_protocols_.clear(); }
 
 #ifdef USE_TEXT_SENSOR
   void set_protocol_text_sensor(text_sensor::TextSensor *sensor) { this->protocol_sensor_ = sensor; }
 #endif
 
   /// Manually dump the last received signal (called by button)
-  void dump_last_signal();
+  void dump_last_signal() { this->dump_signal(0); }
+  /// Dump a stored signal at RAW verbosity; 0 is the most recent one
+  void dump_signal(uint8_t index);
 
   /// Check if we have a signal stored
-  bool has_last_signal() const { return this->last_signal_valid_; }
+  bool has_last_signal() const { return this->history_count_ > 0; }
+  uint8_t get_history_count() const { return this->history_count_; }
 
  protected:
+  /// Dump slot `head - 1 - index` of the `count` most recent ones.
+  void dump_slot_(uint8_t index, uint8_t head, uint8_t count);
+  /// Decode and process a finished capture. Returns false when there is none.
+  bool receive_();
+  /// Decode a finished capture into the next history slot and resume
+  /// receiving. nullptr when there is none.
+  CapturedSignal *capture_();
+  bool is_allowed_(decode_type_t protocol) const;
+  void record_protocol_(decode_type_t protocol, uint32_t decode_us);
+  /// Copy a decoded signal, including its raw timings, into the next history slot.
+  CapturedSignal *store_signal_(const decode_results &results);
   void process_signal_(decode_results *results);
   void log_minimal_(decode_results *results);
   void log_normal_(decode_results *results);
@@ -56,10 +109,51 @@ class IRremoteDebugComponent : public PollingComponent {
   uint16_t buffer_size_{1024};
   uint32_t timeout_ms_{15};
   VerbosityLevel verbosity_{VERBOSITY_NORMAL};
+  DecodeMode decode_mode_{DECODE_MODE_EVENT};
+
+  // Event mode: the loop runs at high frequency until a burst of signals ends
+  HighFrequencyLoopRequester high_freq_;
+  // millis() when the current burst ends, empty outside a burst
+  optional<uint32_t> burst_end_;
+  uint32_t last_check_us_{0};
+  // Loop interval ending in each pickup, an upper bound of the time between a
+  // capture ending and it being decoded
+  uint32_t pickup_interval_max_us_{0};
+  uint64_t pickup_interval_total_us_{0};
+  uint32_t signals_received_{0};
+  uint32_t overflows_{0};
+
+  std::vector<decode_type_t> allowed_protocols_;
+  uint32_t signals_filtered_{0};
+  ProtocolStats protocol_stats_[PROTOCOL_STATS_SIZE]{};
+  uint8_t protocol_stats_count_{0};
+
+#ifdef USE_ESP32
+  // Task mode: the task decodes into history slots and queues their index;
+  // the main loop only logs and publishes
+  static void decode_task_(void *arg);
+  TaskHandle_t decode_task_handle_{nullptr};
+  SPSCQueue<uint8_t, 17> decoded_queue_;
+  // One slot less than the history, so a queued or processing slot is never reused
+  uint8_t queue_capacity_{0};
+  // Slots the main loop has taken off the queue. dump_signal() only reads
+  // these, and holds the task off while it does.
+  uint8_t processed_head_{0};
+  uint8_t processed_count_{0};
+  std::atomic<bool> hold_captures_{false};
+  std::atomic<bool> capturing_{false};
+#endif
+  uint8_t decode_task_core_{0};
 
   IRrecv *ir_receiver_{nullptr};
-  decode_results last_results_;
-  bool last_signal_valid_{false};
+
+  // Ring buffer of the last history_size_ signals. The raw timings of slot i
+  // live at capture_arena_[i * buffer_size_]; both are allocated once in setup().
+  uint8_t history_size_{4};
+  CapturedSignal *history_{nullptr};
+  uint16_t *capture_arena_{nullptr};
+  uint8_t history_head_{0};  // slot the next signal is stored in
+  uint8_t history_count_{0};
 
 #ifdef USE_TEXT_SENSOR
   text_sensor::TextSensor *protocol_sensor_{nullptr};
@@ -0,0 +1,39 @@
+#include "log_line_writer.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace esphome {
+namespace irremote_debug {
+
+void LogLineWriter::printf(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  va_list retry;
+  va_copy(retry, args);
+
+  size_t available = sizeof(this->buffer_) - this->length_;
+  int written = vsnprintf(this->buffer_ + this->length_, available, format, args);
+  if (written >= 0 && static_cast<size_t>(written) >= available && this->length_ > 0) {
+    // Does not fit; drop the partial piece and put it on a fresh line
+    this->buffer_[this->length_] = '\0';
+    this->flush();
+    written = vsnprintf(this->buffer_, sizeof(this->buffer_), format, retry);
+  }
+  va_end(retry);
+  va_end(args);
+
+  if (written > 0)
+    this->length_ = std::min(this->length_ + written, LINE_LENGTH);
+}
+
+void LogLineWriter::flush() {
+  if (this->length_ == 0)
+    return;
+  ESP_LOGI(this->tag_, "%s", this->buffer_);
+  this->length_ = 0;
+}
+
+}  // namespace irremote_debug
+}  // namespace esphome
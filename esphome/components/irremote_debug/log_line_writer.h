@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstddef>
+
+namespace esphome {
+namespace irremote_debug {
+
+/// Formats log output into a fixed buffer and logs it line by line. A piece
+/// that does not fit on the current line starts a new one, so values are
+/// never split across lines. Nothing is allocated on the heap.
+class LogLineWriter {
+ public:
+  // Keeps each line well below the logger's message size
+  static const size_t LINE_LENGTH = 200;
+
+  explicit LogLineWriter(const char *tag) : tag_(tag) {}
+  ~LogLineWriter() { this->flush(); }
+
+  void printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+  /// Log the current line, if any.
+  void flush();
+
+ protected:
+  const char *tag_;
+  char buffer_[LINE_LENGTH + 1];
+  size_t length_{0};
+};
+
+}  // namespace irremote_debug
+}  // namespace esphome
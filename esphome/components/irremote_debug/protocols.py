@@ -0,0 +1,130 @@
+"""IRremoteESP8266 protocols the debugger can decode."""
+
+# Protocol names (as typeToString() prints them) mapped to the suffix of the
+# library's DECODE_/SEND_ flags that compile their decoder in. Most are the
+# same; variants decoded by another protocol's decoder map to that one.
+# Send-only protocols (RAW, PRONTO, GLOBALCACHE, SHERWOOD) are left out.
+IR_PROTOCOLS = {
+    "AIRTON": "AIRTON",
+    "AIRWELL": "AIRWELL",
+    "AIWA_RC_T501": "AIWA_RC_T501",
+    "AMCOR": "AMCOR",
+    "ARGO": "ARGO",
+    "ARRIS": "ARRIS",
+    "BOSCH144": "BOSCH144",
+    "BOSE": "BOSE",
+    "CARRIER_AC": "CARRIER_AC",
+    "CARRIER_AC40": "CARRIER_AC40",
+    "CARRIER_AC64": "CARRIER_AC64",
+    "CARRIER_AC84": "CARRIER_AC84",
+    "CARRIER_AC128": "CARRIER_AC128",
+    "CLIMABUTLER": "CLIMABUTLER",
+    "COOLIX": "COOLIX",
+    "COOLIX48": "COOLIX48",
+    "CORONA_AC": "CORONA_AC",
+    "DAIKIN": "DAIKIN",
+    "DAIKIN2": "DAIKIN2",
+    "DAIKIN64": "DAIKIN64",
+    "DAIKIN128": "DAIKIN128",
+    "DAIKIN152": "DAIKIN152",
+    "DAIKIN160": "DAIKIN160",
+    "DAIKIN176": "DAIKIN176",
+    "DAIKIN200": "DAIKIN200",
+    "DAIKIN216": "DAIKIN216",
+    "DAIKIN312": "DAIKIN312",
+    "DELONGHI_AC": "DELONGHI_AC",
+    "DENON": "DENON",
+    "DISH": "DISH",
+    "DOSHISHA": "DOSHISHA",
+    "ECOCLIM": "ECOCLIM",
+    "ELECTRA_AC": "ELECTRA_AC",
+    "ELITESCREENS": "ELITESCREENS",
+    "EPSON": "EPSON",
+    "FUJITSU_AC": "FUJITSU_AC",
+    "GICABLE": "GICABLE",
+    "GOODWEATHER": "GOODWEATHER",
+    "GORENJE": "GORENJE",
+    "GREE": "GREE",
+    "HAIER_AC": "HAIER_AC",
+    "HAIER_AC160": "HAIER_AC160",
+    "HAIER_AC176": "HAIER_AC176",
+    "HAIER_AC_YRW02": "HAIER_AC_YRW02",
+    "HITACHI_AC": "HITACHI_AC",
+    "HITACHI_AC1": "HITACHI_AC1",
+    "HITACHI_AC2": "HITACHI_AC2",
+    "HITACHI_AC3": "HITACHI_AC3",
+    "HITACHI_AC264": "HITACHI_AC264",
+    "HITACHI_AC296": "HITACHI_AC296",
+    "HITACHI_AC344": "HITACHI_AC344",
+    "HITACHI_AC424": "HITACHI_AC424",
+    "INAX": "INAX",
+    "JVC": "JVC",
+    "KELON": "KELON",
+    "KELON168": "KELON168",
+    "KELVINATOR": "KELVINATOR",
+    "LASERTAG": "LASERTAG",
+    "LEGOPF": "LEGOPF",
+    "LG": "LG",
+    "LG2": "LG",
+    "LUTRON": "LUTRON",
+    "MAGIQUEST": "MAGIQUEST",
+    "METZ": "METZ",
+    "MIDEA": "MIDEA",
+    "MIDEA24": "MIDEA24",
+    "MILESTAG2": "MILESTAG2",
+    "MIRAGE": "MIRAGE",
+    "MITSUBISHI": "MITSUBISHI",
+    "MITSUBISHI2": "MITSUBISHI2",
+    "MITSUBISHI112": "MITSUBISHI112",
+    "MITSUBISHI136": "MITSUBISHI136",
+    "MITSUBISHI_AC": "MITSUBISHI_AC",
+    "MITSUBISHI_HEAVY_88": "MITSUBISHI_HEAVY_88",
+    "MITSUBISHI_HEAVY_152": "MITSUBISHI_HEAVY_152",
+    "MULTIBRACKETS": "MULTIBRACKETS",
+    "MWM": "MWM",
+    "NEC": "NEC",
+    "NEC_LIKE": "NEC",
+    "NEOCLIMA": "NEOCLIMA",
+    "NIKAI": "NIKAI",
+    "PANASONIC": "PANASONIC",
+    "PANASONIC_AC": "PANASONIC_AC",
+    "PANASONIC_AC32": "PANASONIC_AC32",
+    "PIONEER": "PIONEER",
+    "RC5": "RC5",
+    "RC5X": "RC5",
+    "RC6": "RC6",
+    "RCMM": "RCMM",
+    "RHOSS": "RHOSS",
+    "SAMSUNG": "SAMSUNG",
+    "SAMSUNG36": "SAMSUNG36",
+    "SAMSUNG_AC": "SAMSUNG_AC",
+    "SANYO": "SANYO",
+    "SANYO_AC": "SANYO_AC",
+    "SANYO_AC88": "SANYO_AC88",
+    "SANYO_AC152": "SANYO_AC152",
+    "SANYO_LC7461": "SANYO",
+    "SHARP": "SHARP",
+    "SHARP_AC": "SHARP_AC",
+    "SONY": "SONY",
+    "SONY_38K": "SONY",
+    "SYMPHONY": "SYMPHONY",
+    "TCL96AC": "TCL96AC",
+    "TCL112AC": "TCL112AC",
+    "TECHNIBEL_AC": "TECHNIBEL_AC",
+    "TECO": "TECO",
+    "TEKNOPOINT": "TEKNOPOINT",
+    "TOSHIBA_AC": "TOSHIBA_AC",
+    "TOTO": "TOTO",
+    "TRANSCOLD": "TRANSCOLD",
+    "TROTEC": "TROTEC",
+    "TROTEC_3550": "TROTEC_3550",
+    "TRUMA": "TRUMA",
+    "VESTEL_AC": "VESTEL_AC",
+    "VOLTAS": "VOLTAS",
+    "WHIRLPOOL_AC": "WHIRLPOOL_AC",
+    "WHYNTER": "WHYNTER",
+    "WOWWEE": "WOWWEE",
+    "XMP": "XMP",
+    "YORK": "YORK",
+    "ZEPEAL": "ZEPEAL",
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace irremote_debug {
+
+/// Lock-free queue between exactly one producer and one consumer. Each index
+/// is only written by one side, so no locks or critical sections are needed.
+template<typename T, uint8_t N> class SPSCQueue {
+ public:
+  /// Producer side. False when full.
+  bool push(const T &item) {
+    uint8_t head = this->head_.load(std::memory_order_relaxed);
+    uint8_t next = (head + 1) % N;
+    if (next == this->tail_.load(std::memory_order_acquire))
+      return false;
+    this->items_[head] = item;
+    this->head_.store(next, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer side. False when empty.
+  bool pop(T *item) {
+    uint8_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (tail == this->head_.load(std::memory_order_acquire))
+      return false;
+    *item = this->items_[tail];
+    this->tail_.store((tail + 1) % N, std::memory_order_release);
+    return true;
+  }
+
+  /// Items waiting; exact on either side, approximate elsewhere.
+  uint8_t size() const {
+    return (this->head_.load(std::memory_order_acquire) + N - this->tail_.load(std::memory_order_acquire)) % N;
+  }
+
+ protected:
+  T items_[N];
+  std::atomic<uint8_t> head_{0};  // written by the producer
+  std::atomic<uint8_t> tail_{0};  // written by the consumer
+};
+
+}  // namespace irremote_debug
+}  // namespace esphome
@@ -0,0 +1,497 @@
+// Scenario benchmarks for daikin_312 on the host.
+//
+// Each scenario drives the component the way Home Assistant and the device do
+// (scenes, boot restore, external state sync) and counts what it cost: IR
+// frames, bytes encoded, climate state publishes, switch/select publishes and
+// preference writes. The transmitter records frames instead of sending them;
+// every frame must carry valid checksums, blocking sends must not stack up
+// within one main loop iteration, and each scenario checks the settings
+// decoded from the frames it sent. Exits non-zero when any check fails.
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "host_app.h"
+#include "esphome/core/log.h"
+#include "esphome/components/daikin_312/daikin_312.h"
+#include "esphome/components/daikin_312/select/daikin_312_select.h"
+#include "esphome/components/daikin_312/switch/daikin_312_switch.h"
+
+using namespace esphome;
+using namespace esphome::daikin_312;
+using esphome::host::App;
+
+/// Coalescing window configured for every unit, the component's default
+static const uint32_t COALESCE_WINDOW_MS = 50;
+/// Settings are written this long after the last change, see SETTINGS_SAVE_DELAY_MS
+static const uint32_t SETTINGS_SETTLE_MS = 6000;
+
+/// One climate unit as the YAML of a typical install would create it. Never
+/// deleted, like components on the device; the shared bus keeps pointers to it.
+struct Unit {
+  Unit(const std::string &name, uint8_t pin_number, bool external_sync) : pin(pin_number) {
+    this->climate.set_name(name);
+    this->climate.set_pin(&this->pin);
+    this->climate.set_coalesce_window(COALESCE_WINDOW_MS);
+    if (external_sync) {
+      this->external_mode.set_name(name + " external mode");
+      this->external_temperature.set_name(name + " external temperature");
+      this->external_fan_mode.set_name(name + " external fan mode");
+      this->external_swing_mode.set_name(name + " external swing mode");
+      this->climate.set_external_mode_sensor(&this->external_mode);
+      this->climate.set_external_temperature_sensor(&this->external_temperature);
+      this->climate.set_external_fan_mode_sensor(&this->external_fan_mode);
+      this->climate.set_external_swing_mode_sensor(&this->external_swing_mode);
+    }
+
+    this->purify.set_name(name + " purify");
+    this->purify.set_parent(&this->climate);
+    this->purify.set_switch_type(DAIKIN312_SWITCH_PURIFY);
+    // As the switch's codegen sets them
+    this->purify.set_settings_restore_mode(switch_::SWITCH_RESTORE_DEFAULT_ON);
+    this->purify.set_restore_mode(switch_::SWITCH_RESTORE_DISABLED);
+    this->light.set_name(name + " light");
+    this->light.set_parent(&this->climate);
+    this->light.set_select_type(DAIKIN312_SELECT_LIGHT);
+    this->light.traits.set_options({"Off", "Dim", "Bright"});
+    this->beep.set_name(name + " beep");
+    this->beep.set_parent(&this->climate);
+    this->beep.set_select_type(DAIKIN312_SELECT_BEEP);
+    this->beep.traits.set_options({"Off", "Quiet", "Loud"});
+
+    // Same order as the generated main.cpp
+    App.register_component(&this->climate);
+    App.register_component(&this->purify);
+    App.register_component(&this->light);
+    App.register_component(&this->beep);
+  }
+
+  host::HostPin pin;
+  Daikin312Climate climate;
+  Daikin312Switch purify;
+  Daikin312Select light;
+  Daikin312Select beep;
+  text_sensor::TextSensor external_mode;
+  sensor::Sensor external_temperature;
+  text_sensor::TextSensor external_fan_mode;
+  text_sensor::TextSensor external_swing_mode;
+};
+
+/// A frame taken from the host transmitter, decoded with the component's own
+/// state layout.
+class RecordedFrame : public Daikin312State {
+ public:
+  RecordedFrame(uint8_t pin, const uint8_t *raw) : pin(pin) { memcpy(this->raw_, raw, DAIKIN312_STATE_LENGTH); }
+
+  bool has_valid_checksums() const {
+    RecordedFrame expected = *this;
+    expected.update_checksums_();
+    return memcmp(expected.raw_, this->raw_, DAIKIN312_STATE_LENGTH) == 0;
+  }
+
+  uint8_t pin;
+};
+
+/// Collects the frames a scenario sent and counts entity callbacks.
+class Recorder {
+ public:
+  void track(Unit *unit) {
+    auto *bus = Daikin312Bus::get_or_create(&unit->pin, 6);
+    if (this->buses_.insert(bus).second) {
+      this->frames_seen_.push_back(bus->get_soft_transmitter().get_frames_sent());
+      this->bytes_start_.push_back(bus->get_bytes_encoded());
+    }
+    unit->climate.add_on_state_callback([this](climate::Climate & /*climate*/) { this->climate_publishes++; });
+    unit->purify.add_on_state_callback([this](bool /*state*/) { this->entity_publishes++; });
+    unit->light.add_on_state_callback([this](const std::string & /*value*/, size_t /*index*/) {
+      this->entity_publishes++;
+    });
+    unit->beep.add_on_state_callback([this](const std::string & /*value*/, size_t /*index*/) {
+      this->entity_publishes++;
+    });
+  }
+
+  /// Start counting from zero, e.g. once boot has settled.
+  void reset() {
+    size_t i = 0;
+    for (auto *bus : this->buses_)
+      this->bytes_start_[i++] = bus->get_bytes_encoded();
+    this->frames.clear();
+    this->stacked_iterations = 0;
+    this->climate_publishes = 0;
+    this->entity_publishes = 0;
+  }
+
+  /// Collect the frames sent during the last main loop iteration. The host
+  /// transmitter keeps only its last frame, so a second frame on the same pin
+  /// within one iteration is counted but cannot be decoded.
+  void on_loop() {
+    uint32_t sent_in_iteration = 0;
+    size_t i = 0;
+    for (auto *bus : this->buses_) {
+      const auto &transmitter = bus->get_soft_transmitter();
+      uint32_t sent = transmitter.get_frames_sent() - this->frames_seen_[i];
+      this->frames_seen_[i] = transmitter.get_frames_sent();
+      for (uint32_t frame = 0; frame < sent; frame++)
+        this->frames.emplace_back(bus->get_pin(), transmitter.get_last_frame());
+      sent_in_iteration += sent;
+      i++;
+    }
+    if (sent_in_iteration > 1)
+      this->stacked_iterations++;
+  }
+
+  uint32_t get_bytes_encoded() const {
+    uint32_t bytes = 0;
+    size_t i = 0;
+    for (auto *bus : this->buses_)
+      bytes += bus->get_bytes_encoded() - this->bytes_start_[i++];
+    return bytes;
+  }
+
+  std::vector<RecordedFrame> frames;
+  uint32_t stacked_iterations{0};  // iterations that sent more than one blocking frame
+  uint32_t climate_publishes{0};
+  uint32_t entity_publishes{0};
+
+ protected:
+  std::set<Daikin312Bus *> buses_;
+  std::vector<uint32_t> frames_seen_;
+  std::vector<uint32_t> bytes_start_;
+};
+
+struct Result {
+  const char *name;
+  uint32_t frames;
+  uint32_t max_frames;
+  uint32_t bytes_encoded;
+  uint32_t climate_publishes;
+  uint32_t entity_publishes;
+  uint32_t preference_writes;
+  uint32_t loop_iterations;
+  std::vector<std::string> failures;
+};
+
+/// Boots the given units, lets boot restore finish and then records the scenario.
+class Scenario {
+ public:
+  Scenario(const char *name, uint32_t max_frames) : name_(name), max_frames_(max_frames) {}
+
+  void boot(const std::vector<Unit *> &units, bool record_boot = false) {
+    for (auto *unit : units)
+      this->recorder_.track(unit);
+    App.setup();
+    App.add_loop_hook([this]() { this->recorder_.on_loop(); });
+    if (!record_boot) {
+      App.run_for(SETTINGS_SETTLE_MS);
+      this->recorder_.reset();
+    }
+    this->start_writes_ = App.get_preference_writes();
+    this->start_iterations_ = App.get_loop_iterations();
+  }
+
+  /// Let pending frames and the settings save go out before checking.
+  void settle() { App.run_for(SETTINGS_SETTLE_MS); }
+
+  /// The `index`th frame sent in this scenario; a failure if there is none.
+  const RecordedFrame &frame(size_t index) {
+    static const uint8_t NO_FRAME[DAIKIN312_STATE_LENGTH]{};
+    static const RecordedFrame MISSING(0, NO_FRAME);
+    if (index >= this->recorder_.frames.size()) {
+      this->fail("frame " + std::to_string(index) + " was not sent");
+      return MISSING;
+    }
+    return this->recorder_.frames[index];
+  }
+  const RecordedFrame &last_frame() {
+    return this->frame(this->recorder_.frames.empty() ? 0 : this->recorder_.frames.size() - 1);
+  }
+  size_t frame_count() const { return this->recorder_.frames.size(); }
+
+  void expect(const std::string &what, bool condition) {
+    if (!condition)
+      this->fail(what);
+  }
+  void expect_equal(const std::string &what, int actual, int expected) {
+    if (actual != expected)
+      this->fail(what + " is " + std::to_string(actual) + ", expected " + std::to_string(expected));
+  }
+  void fail(const std::string &what) { this->failures_.push_back(what); }
+
+  Result finish() {
+    for (size_t i = 0; i < this->recorder_.frames.size(); i++) {
+      if (!this->recorder_.frames[i].has_valid_checksums())
+        this->fail("frame " + std::to_string(i) + " has invalid checksums");
+    }
+    if (this->recorder_.stacked_iterations > 0)
+      this->fail(std::to_string(this->recorder_.stacked_iterations) + " loop iterations sent more than one frame");
+    if (this->recorder_.frames.size() > this->max_frames_)
+      this->fail("more frames than expected");
+
+    Result result{this->name_,
+                  static_cast<uint32_t>(this->recorder_.frames.size()),
+                  this->max_frames_,
+                  this->recorder_.get_bytes_encoded(),
+                  this->recorder_.climate_publishes,
+                  this->recorder_.entity_publishes,
+                  App.get_preference_writes() - this->start_writes_,
+                  App.get_loop_iterations() - this->start_iterations_,
+                  this->failures_};
+    App.reboot();
+    return result;
+  }
+
+ protected:
+  const char *name_;
+  uint32_t max_frames_;
+  Recorder recorder_;
+  std::vector<std::string> failures_;
+  uint32_t start_writes_{0};
+  uint32_t start_iterations_{0};
+};
+
+/// Check a setting decoded from a recorded frame, e.g.
+/// EXPECT_FRAME(scenario, scenario.last_frame(), mode, DAIKIN312_MODE_COOL)
+#define EXPECT_FRAME(scenario, frame, setting, expected) \
+  (scenario).expect_equal(#frame "." #setting, (frame).get_##setting(), (expected))
+
+/// A Home Assistant scene: one climate call followed by the switch and select
+/// service calls, each arriving in the next main loop iteration.
+static void apply_scene(Unit *unit) {
+  unit->climate.make_call()
+      .set_mode(climate::CLIMATE_MODE_COOL)
+      .set_target_temperature(23)
+      .set_fan_mode(climate::CLIMATE_FAN_HIGH)
+      .set_swing_mode(climate::CLIMATE_SWING_VERTICAL)
+      .perform();
+  App.loop();
+  unit->purify.turn_off();
+  App.loop();
+  unit->light.set_option("Bright");
+}
+
+/// The frame apply_scene() should end with.
+static void expect_scene_frame(Scenario &scenario, const RecordedFrame &frame) {
+  EXPECT_FRAME(scenario, frame, power, true);
+  EXPECT_FRAME(scenario, frame, mode, DAIKIN312_MODE_COOL);
+  EXPECT_FRAME(scenario, frame, temp, 23);
+  EXPECT_FRAME(scenario, frame, fan, DAIKIN312_FAN_MAX);
+  EXPECT_FRAME(scenario, frame, swing_vertical, DAIKIN312_SWING_V_AUTO);
+  EXPECT_FRAME(scenario, frame, swing_horizontal, DAIKIN312_SWING_H_OFF);
+  EXPECT_FRAME(scenario, frame, purify, false);
+  EXPECT_FRAME(scenario, frame, light, DAIKIN312_LIGHT_BRIGHT);
+}
+
+// Pins and names are unique per scenario: buses and preferences outlive reboots
+
+static Result scene_single_unit() {
+  Scenario scenario("ha_scene", 1);
+  auto *unit = new Unit("Living room", 10, false);
+  scenario.boot({unit});
+  apply_scene(unit);
+  scenario.settle();
+  expect_scene_frame(scenario, scenario.last_frame());
+  return scenario.finish();
+}
+
+static Result scene_three_units() {
+  // Blocking sends take turns, one frame per unit
+  Scenario scenario("ha_scene_3_units_1_pin", 3);
+  std::vector<Unit *> units = {new Unit("Bedroom 1", 11, false), new Unit("Bedroom 2", 11, false),
+                               new Unit("Bedroom 3", 11, false)};
+  scenario.boot(units);
+  for (auto *unit : units)
+    unit->climate.make_call().set_mode(climate::CLIMATE_MODE_HEAT).set_target_temperature(21).perform();
+  scenario.settle();
+  scenario.expect_equal("frames", scenario.frame_count(), 3);
+  for (size_t i = 0; i < 3; i++) {
+    const RecordedFrame &frame = scenario.frame(i);
+    EXPECT_FRAME(scenario, frame, power, true);
+    EXPECT_FRAME(scenario, frame, mode, DAIKIN312_MODE_HEAT);
+    EXPECT_FRAME(scenario, frame, temp, 21);
+  }
+  return scenario.finish();
+}
+
+static Result setpoint_drag() {
+  // A slider dragged across 20 values, one call per loop iteration
+  static const uint32_t CALLS = 20;
+  Scenario scenario("setpoint_drag", CALLS * host::LOOP_INTERVAL_MS / COALESCE_WINDOW_MS + 1);
+  auto *unit = new Unit("Office", 12, false);
+  scenario.boot({unit});
+  unit->climate.make_call().set_mode(climate::CLIMATE_MODE_COOL).perform();
+  for (uint32_t i = 0; i < CALLS; i++) {
+    unit->climate.make_call().set_target_temperature(18 + i % 12).perform();
+    App.loop();
+  }
+  scenario.settle();
+  // Where the slider was released
+  EXPECT_FRAME(scenario, scenario.last_frame(), mode, DAIKIN312_MODE_COOL);
+  EXPECT_FRAME(scenario, scenario.last_frame(), temp, 18 + (CALLS - 1) % 12);
+  return scenario.finish();
+}
+
+static Result external_sync_burst() {
+  // The Home Assistant Daikin integration mirrors the unit's state; the
+  // updates only change what is shown and never send IR
+  Scenario scenario("external_sync_burst", 0);
+  auto *unit = new Unit("Kitchen", 13, true);
+  scenario.boot({unit});
+  for (int burst = 0; burst < 10; burst++) {
+    unit->external_mode.publish_state(burst % 2 ? "cool" : "heat");
+    unit->external_temperature.publish_state(20 + burst % 4);
+    unit->external_fan_mode.publish_state("high");
+    unit->external_swing_mode.publish_state("vertical");
+    App.run_for(500);
+  }
+  scenario.settle();
+  scenario.expect_equal("climate.mode", unit->climate.mode, climate::CLIMATE_MODE_COOL);
+  scenario.expect_equal("climate.target_temperature", unit->climate.target_temperature, 21);
+  scenario.expect_equal("climate.swing_mode", unit->climate.swing_mode, climate::CLIMATE_SWING_VERTICAL);
+  return scenario.finish();
+}
+
+static Result external_then_call() {
+  // The remote switched the unit to heat after we sent cool; asking for cool
+  // again is a change and must be sent
+  Scenario scenario("external_then_call", 2);
+  auto *unit = new Unit("Den", 16, true);
+  scenario.boot({unit});
+  unit->climate.make_call().set_mode(climate::CLIMATE_MODE_COOL).perform();
+  App.run_for(1000);
+  unit->external_mode.publish_state("heat");
+  App.run_for(1000);
+  unit->climate.make_call().set_mode(climate::CLIMATE_MODE_COOL).perform();
+  scenario.settle();
+  scenario.expect_equal("frames", scenario.frame_count(), 2);
+  EXPECT_FRAME(scenario, scenario.last_frame(), mode, DAIKIN312_MODE_COOL);
+  return scenario.finish();
+}
+
+static Result sleep_timer() {
+  // The sleep timer runs the quiet sleep preset and switches the unit off;
+  // turning it on again afterwards must not keep the quiet fan
+  Scenario scenario("sleep_timer", 5);
+  auto *unit = new Unit("Nursery", 17, false);
+  scenario.boot({unit});
+  unit->climate.make_call()
+      .set_mode(climate::CLIMATE_MODE_HEAT)
+      .set_fan_mode(climate::CLIMATE_FAN_HIGH)
+      .set_preset(climate::CLIMATE_PRESET_SLEEP)
+      .perform();
+  App.run_for(1000);
+  EXPECT_FRAME(scenario, scenario.last_frame(), quiet, true);
+  unit->climate.make_call().set_preset(climate::CLIMATE_PRESET_NONE).perform();
+  App.run_for(1000);
+  EXPECT_FRAME(scenario, scenario.last_frame(), quiet, false);
+  unit->climate.start_timer(DAIKIN312_TIMER_SLEEP, 60000);
+  App.run_for(61000);
+  EXPECT_FRAME(scenario, scenario.last_frame(), power, false);
+  unit->climate.make_call().set_mode(climate::CLIMATE_MODE_HEAT).perform();
+  scenario.settle();
+  EXPECT_FRAME(scenario, scenario.last_frame(), power, true);
+  EXPECT_FRAME(scenario, scenario.last_frame(), quiet, false);
+  EXPECT_FRAME(scenario, scenario.last_frame(), fan, DAIKIN312_FAN_MAX);
+  return scenario.finish();
+}
+
+static Result local_control_first_offset() {
+  // The first correction after boot goes out right away; only later ones wait
+  // for the minimum change interval
+  Scenario scenario("local_control_boot", 2);
+  auto *unit = new Unit("Hall", 19, false);
+  auto *room = new sensor::Sensor();
+  room->set_name("Hall room temperature");
+  unit->climate.set_sensor(room);
+  unit->climate.set_local_control(DAIKIN312_CONTROL_HYSTERESIS, 2, 300000);
+  unit->climate.set_control_hysteresis(0.5f);
+  scenario.boot({unit});
+  unit->climate.make_call().set_mode(climate::CLIMATE_MODE_HEAT).set_target_temperature(22).perform();
+  App.run_for(1000);
+  room->publish_state(20);
+  scenario.settle();
+  EXPECT_FRAME(scenario, scenario.last_frame(), mode, DAIKIN312_MODE_HEAT);
+  EXPECT_FRAME(scenario, scenario.last_frame(), temp, 23);
+  return scenario.finish();
+}
+
+static Result boot_first() {
+  // Nothing saved yet: at most the defaults, then the scene
+  Scenario scenario("boot_first", 2);
+  auto *unit = new Unit("Study", 14, false);
+  scenario.boot({unit}, true);
+  // Boot restore goes out before the scene arrives
+  App.run_for(1000);
+  apply_scene(unit);
+  scenario.settle();
+  expect_scene_frame(scenario, scenario.last_frame());
+  return scenario.finish();
+}
+
+static Result boot_restore() {
+  // Reboot after boot_first: the restored state is what the unit already has
+  Scenario scenario("boot_restore", 0);
+  auto *unit = new Unit("Study", 15, false);
+  scenario.boot({unit}, true);
+  scenario.settle();
+  scenario.expect_equal("climate.mode", unit->climate.mode, climate::CLIMATE_MODE_COOL);
+  scenario.expect_equal("climate.target_temperature", unit->climate.target_temperature, 23);
+  scenario.expect("purify restored off", !unit->purify.state);
+  scenario.expect("light restored to Bright", unit->light.current_option() == "Bright");
+  return scenario.finish();
+}
+
+static Result legacy_migration() {
+  // Firmware from before the settings blob saved each switch and select on
+  // its own; the first boot with the blob picks those values up
+  Scenario scenario("legacy_migration", 1);
+  auto *unit = new Unit("Attic", 18, false);
+  bool purify = false;
+  size_t light = 1;  // Dim
+  global_preferences->make_preference<bool>(unit->purify.get_preference_hash()).save(&purify);
+  global_preferences->make_preference<size_t>(unit->light.get_preference_hash()).save(&light);
+  scenario.boot({unit}, true);
+  scenario.settle();
+  scenario.expect("purify migrated off", !unit->purify.state);
+  scenario.expect("light migrated to Dim", unit->light.current_option() == "Dim");
+  scenario.expect("purify saved with the settings", unit->climate.has_saved_setting(DAIKIN312_SETTING_PURIFY));
+  scenario.expect("light saved with the settings", unit->climate.has_saved_setting(DAIKIN312_SETTING_LIGHT));
+  EXPECT_FRAME(scenario, scenario.last_frame(), purify, false);
+  EXPECT_FRAME(scenario, scenario.last_frame(), light, DAIKIN312_LIGHT_DIM);
+  return scenario.finish();
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1 && strcmp(argv[1], "-v") == 0)
+    host_log_level = ESPHOME_LOG_LEVEL_DEBUG;
+
+  std::vector<Result> results;
+  results.push_back(scene_single_unit());
+  results.push_back(scene_three_units());
+  results.push_back(setpoint_drag());
+  results.push_back(external_sync_burst());
+  results.push_back(external_then_call());
+  results.push_back(sleep_timer());
+  results.push_back(local_control_first_offset());
+  results.push_back(boot_first());
+  results.push_back(boot_restore());
+  results.push_back(legacy_migration());
+
+  printf("%-24s %8s %10s %9s %9s %9s %9s %10s\n", "scenario", "frames", "max_frames", "bytes", "climate", "entities",
+         "pref_wr", "loop_iter");
+  bool passed = true;
+  for (const auto &result : results) {
+    printf("%-24s %8" PRIu32 " %10" PRIu32 " %9" PRIu32 " %9" PRIu32 " %9" PRIu32 " %9" PRIu32 " %10" PRIu32 "%s\n",
+           result.name, result.frames, result.max_frames, result.bytes_encoded, result.climate_publishes,
+           result.entity_publishes, result.preference_writes, result.loop_iterations,
+           result.failures.empty() ? "" : "  FAIL");
+    for (const auto &failure : result.failures)
+      printf("  %s\n", failure.c_str());
+    passed &= result.failures.empty();
+  }
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+// Host stand-in for esphome/components/climate/climate.h. publish_state()
+// saves the base restore state like ESPHome does, so the bench sees the same
+// preference traffic as a device.
+
+#include <cstring>
+#include <initializer_list>
+#include <string>
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
+#include "climate_mode.h"
+
+namespace esphome {
+namespace climate {
+
+class Climate;
+
+class ClimateTraits {
+ public:
+  void add_feature_flags(uint32_t flags) { this->feature_flags_ |= flags; }
+  void set_supported_modes(std::initializer_list<ClimateMode> /*modes*/) {}
+  void set_visual_min_temperature(float /*temperature*/) {}
+  void set_visual_max_temperature(float /*temperature*/) {}
+  void set_visual_temperature_step(float /*step*/) {}
+  void set_supported_fan_modes(std::initializer_list<ClimateFanMode> /*modes*/) {}
+  void set_supported_custom_fan_modes(std::initializer_list<const char *> /*modes*/) {}
+  void set_supported_swing_modes(std::initializer_list<ClimateSwingMode> /*modes*/) {}
+  void set_supported_presets(std::initializer_list<ClimatePreset> /*presets*/) {}
+
+ protected:
+  uint32_t feature_flags_{0};
+};
+
+/// Non-owning view of the active custom mode name; empty when none is set.
+class StringRef {
+ public:
+  StringRef() = default;
+  explicit StringRef(const char *str) : str_(str) {}
+  bool empty() const { return this->str_ == nullptr || *this->str_ == '\0'; }
+  const char *c_str() const { return this->str_ == nullptr ? "" : this->str_; }
+  bool operator==(const char *other) const { return other != nullptr && strcmp(this->c_str(), other) == 0; }
+  bool operator!=(const char *other) const { return !(*this == other); }
+
+ protected:
+  const char *str_{nullptr};
+};
+
+class ClimateCall {
+ public:
+  explicit ClimateCall(Climate *parent) : parent_(parent) {}
+
+  ClimateCall &set_mode(ClimateMode mode) {
+    this->mode_ = mode;
+    return *this;
+  }
+  ClimateCall &set_target_temperature(float target_temperature) {
+    this->target_temperature_ = target_temperature;
+    return *this;
+  }
+  ClimateCall &set_fan_mode(ClimateFanMode fan_mode) {
+    this->fan_mode_ = fan_mode;
+    this->custom_fan_mode_ = nullptr;
+    return *this;
+  }
+  ClimateCall &set_fan_mode(const char *custom_fan_mode) {
+    this->custom_fan_mode_ = custom_fan_mode;
+    this->fan_mode_.reset();
+    return *this;
+  }
+  ClimateCall &set_swing_mode(ClimateSwingMode swing_mode) {
+    this->swing_mode_ = swing_mode;
+    return *this;
+  }
+  ClimateCall &set_preset(ClimatePreset preset) {
+    this->preset_ = preset;
+    return *this;
+  }
+  void perform();
+
+  const optional<ClimateMode> &get_mode() const { return this->mode_; }
+  const optional<float> &get_target_temperature() const { return this->target_temperature_; }
+  const optional<ClimateFanMode> &get_fan_mode() const { return this->fan_mode_; }
+  const optional<ClimateSwingMode> &get_swing_mode() const { return this->swing_mode_; }
+  const optional<ClimatePreset> &get_preset() const { return this->preset_; }
+  bool has_custom_fan_mode() const { return this->custom_fan_mode_ != nullptr; }
+  const char *get_custom_fan_mode() const { return this->custom_fan_mode_; }
+  bool has_custom_preset() const { return this->custom_preset_ != nullptr; }
+  const char *get_custom_preset() const { return this->custom_preset_; }
+
+ protected:
+  Climate *parent_;
+  optional<ClimateMode> mode_;
+  optional<float> target_temperature_;
+  optional<ClimateFanMode> fan_mode_;
+  optional<ClimateSwingMode> swing_mode_;
+  optional<ClimatePreset> preset_;
+  const char *custom_fan_mode_{nullptr};
+  const char *custom_preset_{nullptr};
+};
+
+/// The climate's own restore state, saved on every publish once set up.
+struct ClimateDeviceRestoreState {
+  ClimateMode mode;
+  float target_temperature;
+  bool has_fan_mode;
+  ClimateFanMode fan_mode;
+  ClimateSwingMode swing_mode;
+  bool has_preset;
+  ClimatePreset preset;
+
+  void apply(Climate *climate);
+} __attribute__((packed));
+
+class Climate : public EntityBase {
+ public:
+  ClimateCall make_call() { return ClimateCall(this); }
+  void publish_state();
+  void add_on_state_callback(std::function<void(Climate &)> &&callback) {
+    this->state_callback_.add(std::move(callback));
+  }
+
+  StringRef get_custom_fan_mode() const { return StringRef(this->custom_fan_mode_); }
+  StringRef get_custom_preset() const { return StringRef(this->custom_preset_); }
+
+  ClimateMode mode{CLIMATE_MODE_OFF};
+  float current_temperature{NAN};
+  float target_temperature{NAN};
+  optional<ClimateFanMode> fan_mode;
+  ClimateSwingMode swing_mode{CLIMATE_SWING_OFF};
+  optional<ClimatePreset> preset;
+
+ protected:
+  friend ClimateCall;
+
+  virtual void control(const ClimateCall &call) = 0;
+  virtual ClimateTraits traits() = 0;
+
+  optional<ClimateDeviceRestoreState> restore_state_();
+  void save_state_();
+  bool set_custom_fan_mode_(const char *mode) {
+    this->custom_fan_mode_ = mode;
+    return true;
+  }
+  void clear_custom_fan_mode_() { this->custom_fan_mode_ = nullptr; }
+  bool set_custom_preset_(const char *preset) {
+    this->custom_preset_ = preset;
+    return true;
+  }
+  void clear_custom_preset_() { this->custom_preset_ = nullptr; }
+
+  CallbackManager<void(Climate &)> state_callback_;
+  ESPPreferenceObject rtc_;
+  const char *custom_fan_mode_{nullptr};
+  const char *custom_preset_{nullptr};
+};
+
+}  // namespace climate
+}  // namespace esphome
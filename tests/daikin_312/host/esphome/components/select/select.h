@@ -0,0 +1,63 @@
+#pragma once
+
+// Host stand-in for esphome/components/select/select.h.
+
+#include <string>
+#include <vector>
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace select {
+
+class SelectTraits {
+ public:
+  void set_options(std::vector<std::string> options) { this->options_ = std::move(options); }
+  const std::vector<std::string> &get_options() const { return this->options_; }
+
+ protected:
+  std::vector<std::string> options_;
+};
+
+class Select : public EntityBase {
+ public:
+  /// Stands in for make_call().set_option(option).perform()
+  void set_option(const std::string &option) { this->control(option); }
+
+  void publish_state(const std::string &state) {
+    auto index = this->index_of(state);
+    if (index.has_value())
+      this->publish_state(index.value());
+  }
+  void publish_state(size_t index) {
+    this->active_index_ = index;
+    this->callback_.call(this->current_option(), index);
+  }
+  void add_on_state_callback(std::function<void(std::string, size_t)> &&callback) {
+    this->callback_.add(std::move(callback));
+  }
+
+  optional<size_t> index_of(const std::string &option) const {
+    const auto &options = this->traits.get_options();
+    for (size_t i = 0; i < options.size(); i++) {
+      if (options[i] == option)
+        return i;
+    }
+    return {};
+  }
+  const char *option_at(size_t index) const { return this->traits.get_options().at(index).c_str(); }
+  optional<size_t> active_index() const { return this->active_index_; }
+  const std::string &current_option() const { return this->traits.get_options().at(this->active_index_.value_or(0)); }
+
+  SelectTraits traits;
+
+ protected:
+  virtual void control(const std::string &value) = 0;
+
+  optional<size_t> active_index_;
+  CallbackManager<void(std::string, size_t)> callback_;
+};
+
+}  // namespace select
+}  // namespace esphome
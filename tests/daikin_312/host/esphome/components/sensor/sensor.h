@@ -0,0 +1,29 @@
+#pragma once
+
+// Host stand-in for esphome/components/sensor/sensor.h.
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace sensor {
+
+class Sensor : public EntityBase {
+ public:
+  void publish_state(float state) {
+    this->state = state;
+    this->has_state_ = true;
+    this->callback_.call(state);
+  }
+  void add_on_state_callback(std::function<void(float)> &&callback) { this->callback_.add(std::move(callback)); }
+  bool has_state() const { return this->has_state_; }
+
+  float state{NAN};
+
+ protected:
+  CallbackManager<void(float)> callback_;
+  bool has_state_{false};
+};
+
+}  // namespace sensor
+}  // namespace esphome
@@ -0,0 +1,61 @@
+#pragma once
+
+// Host stand-in for esphome/components/switch/switch.h.
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
+
+namespace esphome {
+namespace switch_ {
+
+const int RESTORE_MODE_ON_MASK = 0x01;
+const int RESTORE_MODE_PERSISTENT_MASK = 0x02;
+const int RESTORE_MODE_INVERTED_MASK = 0x04;
+const int RESTORE_MODE_DISABLED_MASK = 0x08;
+
+enum SwitchRestoreMode : uint8_t {
+  SWITCH_ALWAYS_OFF = !RESTORE_MODE_ON_MASK,
+  SWITCH_ALWAYS_ON = RESTORE_MODE_ON_MASK,
+  SWITCH_RESTORE_DEFAULT_OFF = RESTORE_MODE_PERSISTENT_MASK,
+  SWITCH_RESTORE_DEFAULT_ON = RESTORE_MODE_PERSISTENT_MASK | RESTORE_MODE_ON_MASK,
+  SWITCH_RESTORE_INVERTED_DEFAULT_OFF = RESTORE_MODE_PERSISTENT_MASK | RESTORE_MODE_INVERTED_MASK,
+  SWITCH_RESTORE_INVERTED_DEFAULT_ON =
+      RESTORE_MODE_PERSISTENT_MASK | RESTORE_MODE_INVERTED_MASK | RESTORE_MODE_ON_MASK,
+  SWITCH_RESTORE_DISABLED = RESTORE_MODE_DISABLED_MASK,
+};
+
+class Switch : public EntityBase {
+ public:
+  void turn_on() { this->write_state(true); }
+  void turn_off() { this->write_state(false); }
+  void publish_state(bool state) {
+    this->state = state;
+    if (this->restore_mode & RESTORE_MODE_PERSISTENT_MASK)
+      this->rtc_.save(&this->state);
+    this->callback_.call(state);
+  }
+  void add_on_state_callback(std::function<void(bool)> &&callback) { this->callback_.add(std::move(callback)); }
+  void set_restore_mode(SwitchRestoreMode restore_mode) { this->restore_mode = restore_mode; }
+
+  /// The state saved by the base switch, which only writes it with a persistent restore mode.
+  optional<bool> get_initial_state() {
+    this->rtc_ = global_preferences->make_preference<bool>(this->get_preference_hash());
+    bool initial_state;
+    if (!this->rtc_.load(&initial_state))
+      return {};
+    return initial_state;
+  }
+
+  bool state{false};
+  SwitchRestoreMode restore_mode{SWITCH_RESTORE_DEFAULT_OFF};
+
+ protected:
+  virtual void write_state(bool state) = 0;
+
+  CallbackManager<void(bool)> callback_;
+  ESPPreferenceObject rtc_;
+};
+
+}  // namespace switch_
+}  // namespace esphome
@@ -0,0 +1,28 @@
+#pragma once
+
+// Host stand-in for esphome/components/text_sensor/text_sensor.h.
+
+#include <string>
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace text_sensor {
+
+class TextSensor : public EntityBase {
+ public:
+  void publish_state(const std::string &state) {
+    this->state = state;
+    this->callback_.call(state);
+  }
+  void add_on_state_callback(std::function<void(std::string)> callback) { this->callback_.add(std::move(callback)); }
+
+  std::string state;
+
+ protected:
+  CallbackManager<void(std::string)> callback_;
+};
+
+}  // namespace text_sensor
+}  // namespace esphome
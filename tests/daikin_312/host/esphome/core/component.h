@@ -0,0 +1,63 @@
+#pragma once
+
+// Host stand-in for esphome/core/component.h. Timeouts, intervals and defers
+// go to the bench's scheduler (see host_app.h), which runs them against
+// virtual time from the simulated main loop.
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+
+namespace setup_priority {
+extern const float BUS;
+extern const float IO;
+extern const float HARDWARE;
+extern const float DATA;
+extern const float PROCESSOR;
+extern const float AFTER_WIFI;
+extern const float AFTER_CONNECTION;
+extern const float LATE;
+}  // namespace setup_priority
+
+class Component {
+ public:
+  virtual ~Component() = default;
+  virtual void setup() {}
+  virtual void loop() {}
+  virtual void dump_config() {}
+  virtual float get_setup_priority() const { return setup_priority::DATA; }
+
+  void mark_failed() { this->failed_ = true; }
+  bool is_failed() const { return this->failed_; }
+  void disable_loop() { this->loop_enabled_ = false; }
+  void enable_loop() { this->loop_enabled_ = true; }
+  void enable_loop_soon_any_context() { this->loop_enabled_ = true; }
+  bool is_loop_enabled() const { return this->loop_enabled_; }
+
+ protected:
+  void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);
+  bool cancel_timeout(const std::string &name);
+  void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);
+  bool cancel_interval(const std::string &name);
+  void defer(const std::string &name, std::function<void()> &&f);
+  void defer(std::function<void()> &&f);
+
+  bool failed_{false};
+  bool loop_enabled_{true};
+};
+
+class EntityBase {
+ public:
+  const char *get_name() const { return this->name_.c_str(); }
+  void set_name(const std::string &name) { this->name_ = name; }
+  uint32_t get_preference_hash() const { return fnv1_hash(this->name_); }
+
+ protected:
+  std::string name_;
+};
+
+}  // namespace esphome
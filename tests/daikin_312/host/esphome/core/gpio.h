@@ -0,0 +1,58 @@
+#pragma once
+
+// Host stand-in for ESPHome's GPIO pin interfaces.
+
+#include <cstdint>
+#include <string>
+
+namespace esphome {
+
+namespace gpio {
+enum Flags : uint8_t {
+  FLAG_NONE = 0x00,
+  FLAG_INPUT = 0x01,
+  FLAG_OUTPUT = 0x02,
+};
+enum InterruptType : uint8_t {
+  INTERRUPT_RISING_EDGE = 1,
+  INTERRUPT_FALLING_EDGE = 2,
+  INTERRUPT_ANY_EDGE = 3,
+};
+}  // namespace gpio
+
+class ISRInternalGPIOPin {
+ public:
+  ISRInternalGPIOPin() = default;
+  explicit ISRInternalGPIOPin(void *arg) : arg_(arg) {}
+  bool digital_read() { return false; }
+  void digital_write(bool /*value*/) {}
+
+ protected:
+  void *arg_{nullptr};
+};
+
+class GPIOPin {
+ public:
+  virtual ~GPIOPin() = default;
+  virtual void setup() = 0;
+  virtual void pin_mode(gpio::Flags flags) = 0;
+  virtual bool digital_read() = 0;
+  virtual void digital_write(bool value) = 0;
+  virtual std::string dump_summary() const = 0;
+};
+
+class InternalGPIOPin : public GPIOPin {
+ public:
+  virtual uint8_t get_pin() const = 0;
+  virtual ISRInternalGPIOPin to_isr() const = 0;
+
+  template<typename T> void attach_interrupt(void (*func)(T *), T *arg, gpio::InterruptType type) const {
+    this->attach_interrupt(reinterpret_cast<void (*)(void *)>(func), arg, type);
+  }
+  virtual void detach_interrupt() const = 0;
+
+ protected:
+  virtual void attach_interrupt(void (*func)(void *), void *arg, gpio::InterruptType type) const = 0;
+};
+
+}  // namespace esphome
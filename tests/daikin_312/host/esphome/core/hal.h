@@ -0,0 +1,20 @@
+#pragma once
+
+// Host stand-in for esphome/core/hal.h. Time is virtual and only advances when
+// the bench runs the main loop, so runs are deterministic.
+
+#include <cstdint>
+
+#include "esphome/core/gpio.h"
+
+#define IRAM_ATTR
+
+namespace esphome {
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void delay_microseconds_safe(uint32_t us);
+
+}  // namespace esphome
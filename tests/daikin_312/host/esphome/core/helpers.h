@@ -0,0 +1,69 @@
+#pragma once
+
+// Host stand-in for the parts of esphome/core/helpers.h used by the components.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <math.h>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace esphome {
+
+template<typename T> using optional = std::optional<T>;
+
+template<typename T> T clamp(T value, T min, T max) {
+  if (value < min)
+    return min;
+  if (value > max)
+    return max;
+  return value;
+}
+
+uint32_t fnv1_hash(const std::string &str);
+std::string format_hex_pretty(const uint8_t *data, size_t length);
+
+template<typename... X> class CallbackManager;
+
+template<typename... Ts> class CallbackManager<void(Ts...)> {
+ public:
+  void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+  void call(Ts... args) {
+    for (auto &cb : this->callbacks_)
+      cb(args...);
+  }
+  size_t size() const { return this->callbacks_.size(); }
+
+ protected:
+  std::vector<std::function<void(Ts...)>> callbacks_;
+};
+
+template<typename T> class Parented {
+ public:
+  Parented() {}
+  Parented(T *parent) : parent_(parent) {}
+  T *get_parent() const { return this->parent_; }
+  void set_parent(T *parent) { this->parent_ = parent; }
+
+ protected:
+  T *parent_{nullptr};
+};
+
+/// No interrupts on the host; the bench is single threaded.
+class InterruptLock {
+ public:
+  InterruptLock() {}
+  ~InterruptLock() {}
+};
+
+template<class T> class RAMAllocator {
+ public:
+  T *allocate(size_t n) { return new T[n]; }  // NOLINT(cppcoreguidelines-owning-memory)
+  void deallocate(T *p, size_t n) { delete[] p; }  // NOLINT(cppcoreguidelines-owning-memory)
+};
+
+}  // namespace esphome
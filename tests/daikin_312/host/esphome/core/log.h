@@ -0,0 +1,55 @@
+#pragma once
+
+// Host stand-in for the ESPHome logger: printf-style output filtered by level.
+
+#include <cstdio>
+
+#define ESPHOME_LOG_LEVEL_NONE 0
+#define ESPHOME_LOG_LEVEL_ERROR 1
+#define ESPHOME_LOG_LEVEL_WARN 2
+#define ESPHOME_LOG_LEVEL_INFO 3
+#define ESPHOME_LOG_LEVEL_CONFIG 4
+#define ESPHOME_LOG_LEVEL_DEBUG 5
+#define ESPHOME_LOG_LEVEL_VERBOSE 6
+#define ESPHOME_LOG_LEVEL_VERY_VERBOSE 7
+
+namespace esphome {
+
+/// Messages above this level are dropped; set by the bench from its arguments.
+extern int host_log_level;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void esp_log_printf_(int level, const char *tag, int line, const char *format, ...)  // NOLINT
+    __attribute__((format(printf, 4, 5)));
+
+/// Entities are logged through `this` in dump_config(); comparing `this` itself
+/// with nullptr would warn.
+inline bool log_entity_present_(const void *obj) { return obj != nullptr; }
+
+}  // namespace esphome
+
+#define ESP_LOGE(tag, ...) ::esphome::esp_log_printf_(ESPHOME_LOG_LEVEL_ERROR, tag, __LINE__, __VA_ARGS__)
+#define ESP_LOGW(tag, ...) ::esphome::esp_log_printf_(ESPHOME_LOG_LEVEL_WARN, tag, __LINE__, __VA_ARGS__)
+#define ESP_LOGI(tag, ...) ::esphome::esp_log_printf_(ESPHOME_LOG_LEVEL_INFO, tag, __LINE__, __VA_ARGS__)
+#define ESP_LOGCONFIG(tag, ...) ::esphome::esp_log_printf_(ESPHOME_LOG_LEVEL_CONFIG, tag, __LINE__, __VA_ARGS__)
+#define ESP_LOGD(tag, ...) ::esphome::esp_log_printf_(ESPHOME_LOG_LEVEL_DEBUG, tag, __LINE__, __VA_ARGS__)
+#define ESP_LOGV(tag, ...) ::esphome::esp_log_printf_(ESPHOME_LOG_LEVEL_VERBOSE, tag, __LINE__, __VA_ARGS__)
+#define ESP_LOGVV(tag, ...) ::esphome::esp_log_printf_(ESPHOME_LOG_LEVEL_VERY_VERBOSE, tag, __LINE__, __VA_ARGS__)
+
+#define LOG_STR(s) (s)
+#define LOG_STR_ARG(s) (s)
+#define ONOFF(b) ((b) ? "ON" : "OFF")
+#define YESNO(b) ((b) ? "YES" : "NO")
+
+#define LOG_PIN(prefix, pin) \
+  if ((pin) != nullptr) { \
+    ESP_LOGCONFIG(TAG, prefix "%s", (pin)->dump_summary().c_str()); \
+  }
+#define LOG_ENTITY_(prefix, type, obj) \
+  if (::esphome::log_entity_present_(obj)) { \
+    ESP_LOGCONFIG(TAG, "%s%s '%s'", prefix, type, (obj)->get_name()); \
+  }
+#define LOG_CLIMATE(prefix, type, obj) LOG_ENTITY_(prefix, type, obj)
+#define LOG_SENSOR(prefix, type, obj) LOG_ENTITY_(prefix, type, obj)
+#define LOG_TEXT_SENSOR(prefix, type, obj) LOG_ENTITY_(prefix, type, obj)
+#define LOG_SWITCH(prefix, type, obj) LOG_ENTITY_(prefix, type, obj)
+#define LOG_SELECT(prefix, type, obj) LOG_ENTITY_(prefix, type, obj)
@@ -0,0 +1,42 @@
+#pragma once
+
+// Host stand-in for ESPHome preferences, kept in memory so a bench scenario
+// can "reboot" by setting up new components against the saved data.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+
+class ESPPreferenceObject {
+ public:
+  ESPPreferenceObject() = default;
+  ESPPreferenceObject(uint32_t type, size_t length) : type_(type), length_(length), valid_(true) {}
+
+  template<typename T> bool save(const T *src) {
+    return this->valid_ && this->save_(reinterpret_cast<const uint8_t *>(src), sizeof(T));
+  }
+  template<typename T> bool load(T *dest) {
+    return this->valid_ && this->load_(reinterpret_cast<uint8_t *>(dest), sizeof(T));
+  }
+
+ protected:
+  bool save_(const uint8_t *data, size_t length);
+  bool load_(uint8_t *data, size_t length);
+
+  uint32_t type_{0};
+  size_t length_{0};
+  bool valid_{false};
+};
+
+class ESPPreferences {
+ public:
+  template<typename T> ESPPreferenceObject make_preference(uint32_t type, bool /*in_flash*/ = false) {
+    return ESPPreferenceObject(type, sizeof(T));
+  }
+  bool sync() { return true; }
+};
+
+extern ESPPreferences *global_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace esphome
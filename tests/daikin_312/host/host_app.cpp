@@ -0,0 +1,278 @@
+#include "host_app.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
+#include "esphome/components/climate/climate.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <map>
+#include <memory>
+
+namespace esphome {
+
+// Virtual time; only advanced by HostApp::loop()
+static uint64_t now_us = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+uint32_t millis() { return static_cast<uint32_t>(now_us / 1000); }
+uint32_t micros() { return static_cast<uint32_t>(now_us); }
+void delay(uint32_t ms) { now_us += static_cast<uint64_t>(ms) * 1000; }
+void delayMicroseconds(uint32_t us) { now_us += us; }
+void delay_microseconds_safe(uint32_t us) { now_us += us; }
+
+namespace setup_priority {
+const float BUS = 1000.0f;
+const float IO = 900.0f;
+const float HARDWARE = 800.0f;
+const float DATA = 600.0f;
+const float PROCESSOR = 400.0f;
+const float AFTER_WIFI = 200.0f;
+const float AFTER_CONNECTION = 100.0f;
+const float LATE = -100.0f;
+}  // namespace setup_priority
+
+int host_log_level = ESPHOME_LOG_LEVEL_WARN;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void esp_log_printf_(int level, const char *tag, int line, const char *format, ...) {  // NOLINT
+  static const char LEVEL_LETTERS[] = "-EWICDVV";
+  if (level > host_log_level)
+    return;
+  printf("[%7.3f][%c][%s:%d]: ", now_us / 1e6, LEVEL_LETTERS[level], tag, line);
+  va_list args;
+  va_start(args, format);
+  vprintf(format, args);
+  va_end(args);
+  printf("\n");
+}
+
+uint32_t fnv1_hash(const std::string &str) {
+  uint32_t hash = 2166136261UL;
+  for (char c : str) {
+    hash *= 16777619UL;
+    hash ^= c;
+  }
+  return hash;
+}
+
+std::string format_hex_pretty(const uint8_t *data, size_t length) {
+  static const char HEX_DIGITS[] = "0123456789ABCDEF";
+  std::string result;
+  for (size_t i = 0; i < length; i++) {
+    if (i > 0)
+      result += '.';
+    result += HEX_DIGITS[data[i] >> 4];
+    result += HEX_DIGITS[data[i] & 0x0F];
+  }
+  return result + " (" + std::to_string(length) + ")";
+}
+
+// Preferences live in memory for the whole process, across reboots
+static std::map<uint32_t, std::vector<uint8_t>> preference_store;  // NOLINT
+static uint32_t preference_writes = 0;                              // NOLINT
+static ESPPreferences host_preferences;                             // NOLINT
+ESPPreferences *global_preferences = &host_preferences;             // NOLINT
+
+bool ESPPreferenceObject::save_(const uint8_t *data, size_t length) {
+  if (length != this->length_)
+    return false;
+  preference_store[this->type_].assign(data, data + length);
+  preference_writes++;
+  return true;
+}
+
+bool ESPPreferenceObject::load_(uint8_t *data, size_t length) {
+  auto it = preference_store.find(this->type_);
+  if (length != this->length_ || it == preference_store.end() || it->second.size() != length)
+    return false;
+  memcpy(data, it->second.data(), length);
+  return true;
+}
+
+// Scheduler; items added while it runs are due in the next loop iteration at
+// the earliest, like ESPHome's
+struct SchedulerItem {
+  Component *component;
+  std::string name;
+  bool interval;
+  uint32_t period;
+  uint64_t due_ms;
+  uint64_t sequence;
+  std::function<void()> callback;
+  bool removed;
+};
+
+static std::vector<std::unique_ptr<SchedulerItem>> scheduler_items;  // NOLINT
+static uint64_t scheduler_sequence = 0;                               // NOLINT
+
+static bool scheduler_cancel(Component *component, const std::string &name, bool interval) {
+  bool found = false;
+  for (auto &item : scheduler_items) {
+    if (!item->removed && item->component == component && item->interval == interval && item->name == name) {
+      item->removed = true;
+      found = true;
+    }
+  }
+  return found;
+}
+
+static void scheduler_add(Component *component, const std::string &name, bool interval, uint32_t delay,
+                          std::function<void()> &&callback) {
+  if (!name.empty())
+    scheduler_cancel(component, name, interval);
+  auto item = std::make_unique<SchedulerItem>();
+  item->component = component;
+  item->name = name;
+  item->interval = interval;
+  item->period = delay;
+  item->due_ms = now_us / 1000 + delay;
+  item->sequence = scheduler_sequence++;
+  item->callback = std::move(callback);
+  item->removed = false;
+  scheduler_items.push_back(std::move(item));
+}
+
+static void scheduler_call() {
+  uint64_t now_ms = now_us / 1000;
+  uint64_t added_before = scheduler_sequence;
+  std::vector<SchedulerItem *> due;
+  for (auto &item : scheduler_items) {
+    if (!item->removed && item->due_ms <= now_ms && item->sequence < added_before)
+      due.push_back(item.get());
+  }
+  std::stable_sort(due.begin(), due.end(), [](const SchedulerItem *a, const SchedulerItem *b) {
+    return a->due_ms != b->due_ms ? a->due_ms < b->due_ms : a->sequence < b->sequence;
+  });
+
+  for (auto *item : due) {
+    // Cancelled by an earlier callback of this pass
+    if (item->removed || item->component->is_failed())
+      continue;
+    if (item->interval) {
+      item->due_ms = now_ms + std::max<uint32_t>(item->period, 1);
+    } else {
+      item->removed = true;
+    }
+    item->callback();
+  }
+
+  scheduler_items.erase(std::remove_if(scheduler_items.begin(), scheduler_items.end(),
+                                       [](const std::unique_ptr<SchedulerItem> &item) { return item->removed; }),
+                        scheduler_items.end());
+}
+
+void Component::set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {
+  scheduler_add(this, name, false, timeout, std::move(f));
+}
+bool Component::cancel_timeout(const std::string &name) { return scheduler_cancel(this, name, false); }
+void Component::set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f) {
+  scheduler_add(this, name, true, interval, std::move(f));
+}
+bool Component::cancel_interval(const std::string &name) { return scheduler_cancel(this, name, true); }
+void Component::defer(const std::string &name, std::function<void()> &&f) {
+  scheduler_add(this, name, false, 0, std::move(f));
+}
+void Component::defer(std::function<void()> &&f) { scheduler_add(this, "", false, 0, std::move(f)); }
+
+namespace climate {
+
+const char *climate_mode_to_string(ClimateMode mode) {
+  static const char *const NAMES[] = {"OFF", "HEAT_COOL", "COOL", "HEAT", "FAN_ONLY", "DRY", "AUTO"};
+  return mode < sizeof(NAMES) / sizeof(NAMES[0]) ? NAMES[mode] : "UNKNOWN";
+}
+const char *climate_fan_mode_to_string(ClimateFanMode fan_mode) {
+  static const char *const NAMES[] = {"ON", "OFF", "AUTO", "LOW", "MEDIUM", "HIGH", "MIDDLE", "FOCUS", "DIFFUSE", "QUIET"};
+  return fan_mode < sizeof(NAMES) / sizeof(NAMES[0]) ? NAMES[fan_mode] : "UNKNOWN";
+}
+const char *climate_swing_mode_to_string(ClimateSwingMode swing_mode) {
+  static const char *const NAMES[] = {"OFF", "BOTH", "VERTICAL", "HORIZONTAL"};
+  return swing_mode < sizeof(NAMES) / sizeof(NAMES[0]) ? NAMES[swing_mode] : "UNKNOWN";
+}
+const char *climate_preset_to_string(ClimatePreset preset) {
+  static const char *const NAMES[] = {"NONE", "HOME", "AWAY", "BOOST", "COMFORT", "ECO", "SLEEP", "ACTIVITY"};
+  return preset < sizeof(NAMES) / sizeof(NAMES[0]) ? NAMES[preset] : "UNKNOWN";
+}
+
+void ClimateCall::perform() { this->parent_->control(*this); }
+
+void ClimateDeviceRestoreState::apply(Climate *climate) {
+  climate->mode = this->mode;
+  climate->target_temperature = this->target_temperature;
+  if (this->has_fan_mode)
+    climate->fan_mode = this->fan_mode;
+  climate->swing_mode = this->swing_mode;
+  if (this->has_preset)
+    climate->preset = this->preset;
+  climate->publish_state();
+}
+
+void Climate::publish_state() {
+  this->state_callback_.call(*this);
+  this->save_state_();
+}
+
+optional<ClimateDeviceRestoreState> Climate::restore_state_() {
+  this->rtc_ = global_preferences->make_preference<ClimateDeviceRestoreState>(this->get_preference_hash());
+  ClimateDeviceRestoreState recovered{};
+  if (!this->rtc_.load(&recovered))
+    return {};
+  return recovered;
+}
+
+void Climate::save_state_() {
+  ClimateDeviceRestoreState state{};
+  state.mode = this->mode;
+  state.target_temperature = this->target_temperature;
+  state.has_fan_mode = this->fan_mode.has_value();
+  state.fan_mode = this->fan_mode.value_or(CLIMATE_FAN_AUTO);
+  state.swing_mode = this->swing_mode;
+  state.has_preset = this->preset.has_value();
+  state.preset = this->preset.value_or(CLIMATE_PRESET_NONE);
+  // A no-op unless restore_state_() has set up the preference
+  this->rtc_.save(&state);
+}
+
+}  // namespace climate
+
+namespace host {
+
+HostApp App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void HostApp::setup() {
+  std::stable_sort(this->components_.begin(), this->components_.end(), [](Component *a, Component *b) {
+    return a->get_setup_priority() > b->get_setup_priority();
+  });
+  for (auto *component : this->components_)
+    component->setup();
+  for (auto *component : this->components_)
+    component->dump_config();
+}
+
+void HostApp::loop() {
+  scheduler_call();
+  for (auto *component : this->components_) {
+    if (component->is_loop_enabled() && !component->is_failed())
+      component->loop();
+  }
+  this->loop_iterations_++;
+  for (auto &hook : this->loop_hooks_)
+    hook();
+  now_us += LOOP_INTERVAL_MS * 1000;
+}
+
+void HostApp::run_for(uint32_t ms) {
+  uint64_t end = now_us + static_cast<uint64_t>(ms) * 1000;
+  while (now_us < end)
+    this->loop();
+}
+
+void HostApp::reboot() {
+  this->components_.clear();
+  this->loop_hooks_.clear();
+  scheduler_items.clear();
+}
+
+uint32_t HostApp::get_preference_writes() const { return preference_writes; }
+
+}  // namespace host
+}  // namespace esphome
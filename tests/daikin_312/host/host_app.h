@@ -0,0 +1,68 @@
+#pragma once
+
+// Simulated ESPHome application for host runs of the daikin_312 component.
+// Components are set up in priority order and the main loop runs against a
+// virtual clock, so every run of a scenario does exactly the same work.
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "esphome/core/component.h"
+#include "esphome/core/gpio.h"
+
+namespace esphome {
+namespace host {
+
+/// Main loop interval of ESPHome when nothing requests a faster loop.
+static const uint32_t LOOP_INTERVAL_MS = 16;
+
+class HostApp {
+ public:
+  void register_component(Component *component) { this->components_.push_back(component); }
+  void setup();
+  /// One main loop iteration: due scheduler items, then every enabled loop().
+  void loop();
+  /// Run main loop iterations until `ms` of virtual time have passed.
+  void run_for(uint32_t ms);
+  /// Drop every component and pending scheduler item. Preferences are kept,
+  /// so components set up afterwards start from what was saved before.
+  void reboot();
+
+  /// Called after every loop iteration, e.g. to record frames sent in it.
+  void add_loop_hook(std::function<void()> &&hook) { this->loop_hooks_.push_back(std::move(hook)); }
+
+  uint32_t get_loop_iterations() const { return this->loop_iterations_; }
+  uint32_t get_preference_writes() const;
+
+ protected:
+  std::vector<Component *> components_;
+  std::vector<std::function<void()>> loop_hooks_;
+  uint32_t loop_iterations_{0};
+};
+
+extern HostApp App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+/// Output pin that only remembers its number; on the host the IR transmitter
+/// records frames instead of toggling it.
+class HostPin : public InternalGPIOPin {
+ public:
+  explicit HostPin(uint8_t pin) : pin_(pin) {}
+  void setup() override {}
+  void pin_mode(gpio::Flags /*flags*/) override {}
+  bool digital_read() override { return false; }
+  void digital_write(bool /*value*/) override {}
+  std::string dump_summary() const override { return "GPIO" + std::to_string(this->pin_); }
+  uint8_t get_pin() const override { return this->pin_; }
+  ISRInternalGPIOPin to_isr() const override { return ISRInternalGPIOPin(nullptr); }
+  void detach_interrupt() const override {}
+
+ protected:
+  void attach_interrupt(void (* /*func*/)(void *), void * /*arg*/, gpio::InterruptType /*type*/) const override {}
+
+  uint8_t pin_;
+};
+
+}  // namespace host
+}  // namespace esphome